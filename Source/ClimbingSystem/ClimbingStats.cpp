@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbingStats.h"
+
+DEFINE_STAT(STAT_PhysClimb);
+DEFINE_STAT(STAT_TraceClimbableSurfaces);
+DEFINE_STAT(STAT_ProcessClimbableSurfaceInfo);
+DEFINE_STAT(STAT_CheckHasReachedFloor);
+DEFINE_STAT(STAT_CheckHasReachedLedge);
+DEFINE_STAT(STAT_CanStartVaulting);
+DEFINE_STAT(STAT_CheckCanHopUp);
+DEFINE_STAT(STAT_CheckCanHopDown);
+DEFINE_STAT(STAT_CheckCanHopRight);
+DEFINE_STAT(STAT_CheckCanHopLeft);
+DEFINE_STAT(STAT_TryAnalogHop);
+
+DEFINE_STAT(STAT_ClimbTracesIssued);
+DEFINE_STAT(STAT_ClimbTraceHits);
+DEFINE_STAT(STAT_ClimbBakedGraphProbes);
+DEFINE_STAT(STAT_ClimbAnalyticProbes);
+DEFINE_STAT(STAT_ClimbQueriesDeferred);
+
+CSV_DEFINE_CATEGORY(Climbing, true);
+
+UE_TRACE_CHANNEL_DEFINE(ClimbChannel);
+
+UE_TRACE_EVENT_BEGIN(Climbing, Probe)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+	UE_TRACE_EVENT_FIELD(uint8, Shape)
+	UE_TRACE_EVENT_FIELD(int32, NumHits)
+	UE_TRACE_EVENT_FIELD(float, StartX)
+	UE_TRACE_EVENT_FIELD(float, StartY)
+	UE_TRACE_EVENT_FIELD(float, StartZ)
+	UE_TRACE_EVENT_FIELD(float, EndX)
+	UE_TRACE_EVENT_FIELD(float, EndY)
+	UE_TRACE_EVENT_FIELD(float, EndZ)
+UE_TRACE_EVENT_END()
+
+namespace ClimbStats
+{
+	void RecordProbe(EClimbProbeShape Shape, const FVector& Start, const FVector& End, int32 NumHits)
+	{
+		if (Shape == EClimbProbeShape::BakedGraph)
+		{
+			INC_DWORD_STAT(STAT_ClimbBakedGraphProbes);
+			CSV_CUSTOM_STAT(Climbing, BakedGraphProbes, 1, ECsvCustomStatOp::Accumulate);
+		}
+		else if (Shape == EClimbProbeShape::Analytic)
+		{
+			INC_DWORD_STAT(STAT_ClimbAnalyticProbes);
+			CSV_CUSTOM_STAT(Climbing, AnalyticProbes, 1, ECsvCustomStatOp::Accumulate);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_ClimbTracesIssued);
+			INC_DWORD_STAT_BY(STAT_ClimbTraceHits, NumHits);
+			CSV_CUSTOM_STAT(Climbing, TracesIssued, 1, ECsvCustomStatOp::Accumulate);
+			CSV_CUSTOM_STAT(Climbing, TraceHits, NumHits, ECsvCustomStatOp::Accumulate);
+		}
+
+		UE_TRACE_LOG(Climbing, Probe, ClimbChannel)
+			<< Probe.Cycle(FPlatformTime::Cycles64())
+			<< Probe.ThreadId(FPlatformTLS::GetCurrentThreadId())
+			<< Probe.Shape((uint8)Shape)
+			<< Probe.NumHits(NumHits)
+			<< Probe.StartX((float)Start.X)
+			<< Probe.StartY((float)Start.Y)
+			<< Probe.StartZ((float)Start.Z)
+			<< Probe.EndX((float)End.X)
+			<< Probe.EndY((float)End.Y)
+			<< Probe.EndZ((float)End.Z);
+	}
+}
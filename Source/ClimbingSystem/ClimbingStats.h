@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Trace.h"
+
+//"stat Climbing" in game, "-csvCategories=Climbing" or "csvprofile start" for capture runs, "-trace=cpu,Climb" for Insights
+
+DECLARE_STATS_GROUP(TEXT("Climbing"), STATGROUP_Climbing, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysClimb"), STAT_PhysClimb, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TraceClimbableSurfaces"), STAT_TraceClimbableSurfaces, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ProcessClimbableSurfaceInfo"), STAT_ProcessClimbableSurfaceInfo, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckHasReachedFloor"), STAT_CheckHasReachedFloor, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckHasReachedLedge"), STAT_CheckHasReachedLedge, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CanStartVaulting"), STAT_CanStartVaulting, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckCanHopUp"), STAT_CheckCanHopUp, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckCanHopDown"), STAT_CheckCanHopDown, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckCanHopRight"), STAT_CheckCanHopRight, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckCanHopLeft"), STAT_CheckCanHopLeft, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TryAnalogHop"), STAT_TryAnalogHop, STATGROUP_Climbing, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_ClimbTracesIssued, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trace Hits"), STAT_ClimbTraceHits, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Baked Graph Probes"), STAT_ClimbBakedGraphProbes, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Analytic Probes"), STAT_ClimbAnalyticProbes, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Queries Deferred"), STAT_ClimbQueriesDeferred, STATGROUP_Climbing, );
+
+CSV_DECLARE_CATEGORY_EXTERN(Climbing);
+
+UE_TRACE_CHANNEL_EXTERN(ClimbChannel);
+
+//Both the cycle stat and the CSV timer for one climb function
+#define CLIMB_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_##Name); \
+	CSV_SCOPED_TIMING_STAT(Climbing, Name)
+
+enum class EClimbProbeShape : uint8
+{
+	Capsule,
+	Line,
+	AsyncCapsule,
+	AsyncLine,
+	BakedGraph,
+	Overlap,
+	Analytic
+};
+
+namespace ClimbStats
+{
+	//Counts the probe and, when the Climb trace channel is on, records its shape, extent and outcome
+	void RecordProbe(EClimbProbeShape Shape, const FVector& Start, const FVector& End, int32 NumHits);
+}
@@ -14,7 +14,10 @@ public class ClimbingSystem : ModuleRules
 			"Engine",
 			"InputCore",
 			"EnhancedInput",
-            "MotionWarping"
+            "MotionWarping",
+			"AnimationBudgetAllocator",
+			"Json",
+			"ReplicationGraph"
         });
 	}
 }
@@ -11,6 +11,8 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "MotionWarpingComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
 
 #include "DebugHelper.h"
 
@@ -20,7 +22,9 @@ DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 // AClimbingSystemCharacter
 
 AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer& ObjectInitializer)
-	:Super(ObjectInitializer.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName))
+	:Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
@@ -56,6 +60,12 @@ AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer& Obj
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
 	MotionWarpingComponent = CreateDefaultSubobject<UMotionWarpingComponent>(TEXT("MotionWarpingComp"));
+
+	// Budgeting is opt-in per character, see BeginPlay
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoRegisterWithBudgetAllocator(false);
+	}
 }
 
 void AClimbingSystemCharacter::BeginPlay()
@@ -70,6 +80,94 @@ void AClimbingSystemCharacter::BeginPlay()
 		CustomMovementComponent->OnEnterClimbStateDelegate.BindUObject(this, &ThisClass::OnPlayerEnterClimbState);
 		CustomMovementComponent->OnExitClimbStateDelegate.BindUObject(this, &ThisClass::OnPlayerExitClimbState);
 	}
+
+	if (bUseAnimationBudget || bUseUpdateRateOptimizations)
+	{
+		USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+
+		if (bUseAnimationBudget && BudgetedMesh)
+		{
+			if (IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld()))
+			{
+				BudgetedMesh->SetAutoCalculateSignificance(false);
+				BudgetAllocator->RegisterComponent(BudgetedMesh);
+				bRegisteredWithAnimationBudget = true;
+			}
+		}
+		else
+		{
+			GetMesh()->bEnableUpdateRateOptimizations = true;
+		}
+
+		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+		{
+			AnimInstance->OnMontageStarted.AddDynamic(this, &ThisClass::OnAnimMontageStarted);
+			AnimInstance->OnMontageEnded.AddDynamic(this, &ThisClass::OnAnimMontageEnded);
+		}
+
+		GetWorldTimerManager().SetTimer(AnimationSignificanceTimerHandle, this, &ThisClass::UpdateAnimationSignificance, AnimationSignificanceInterval, true);
+		UpdateAnimationSignificance();
+	}
+}
+
+void AClimbingSystemCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	//Proxies replay climb actions from the movement component's transition event, sending the root motion group as well would pay for it twice
+	if (CustomMovementComponent && CustomMovementComponent->IsClimbActionReplicatedAsEvent())
+	{
+		RepRootMotion.Clear();
+	}
+}
+
+void AClimbingSystemCharacter::UpdateAnimationSignificance()
+{
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+
+	// Montage driven transitions (hops, vault, climb to top) always run at full rate so motion warping stays exact
+	const bool bInClimbTransition = AnimInstance && AnimInstance->IsAnyMontagePlaying();
+	const bool bFullRate = bInClimbTransition || IsLocallyControlled();
+
+	if (bRegisteredWithAnimationBudget)
+	{
+		float ClosestViewDistanceSquared = MAX_flt;
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (!PlayerController || !PlayerController->IsLocalController()) continue;
+
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			ClosestViewDistanceSquared = FMath::Min(ClosestViewDistanceSquared, FVector::DistSquared(ViewLocation, GetActorLocation()));
+		}
+
+		float Significance = bFullRate ? 1.f : AnimationSignificanceDistance / (AnimationSignificanceDistance + FMath::Sqrt(ClosestViewDistanceSquared));
+
+		const bool bHangingIdle = CustomMovementComponent && CustomMovementComponent->IsClimbing() && GetVelocity().IsNearlyZero(1.f);
+		if (bHangingIdle && !bFullRate)
+		{
+			Significance *= IdleClimbSignificanceScale;
+		}
+
+		CastChecked<USkeletalMeshComponentBudgeted>(GetMesh())->SetComponentSignificance(Significance, bFullRate, false, !bFullRate);
+	}
+	else
+	{
+		GetMesh()->bEnableUpdateRateOptimizations = !bFullRate;
+	}
+}
+
+void AClimbingSystemCharacter::OnAnimMontageStarted(UAnimMontage* Montage)
+{
+	UpdateAnimationSignificance();
+}
+
+void AClimbingSystemCharacter::OnAnimMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	UpdateAnimationSignificance();
 }
 
 void AClimbingSystemCharacter::AddInputMappingContext(UInputMappingContext* ContextToAdd, int32 InPriority)
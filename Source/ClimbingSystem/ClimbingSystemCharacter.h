@@ -14,6 +14,7 @@ class UInputMappingContext;
 class UInputAction;
 class UCustomMovementComponent;
 class UMotionWarpingComponent;
+class UAnimMontage;
 
 struct FInputActionValue;
 
@@ -99,6 +100,39 @@ private:
 	void OnClimbHopActionStarted(const FInputActionValue& Value);
 #pragma endregion
 
+#pragma region AnimationBudget
+	void UpdateAnimationSignificance();
+
+	UFUNCTION()
+	void OnAnimMontageStarted(UAnimMontage* Montage);
+
+	UFUNCTION()
+	void OnAnimMontageEnded(UAnimMontage* Montage, bool bInterrupted);
+
+	/** Register the mesh with the Animation Budget Allocator so animation cost stays inside a fixed per-frame budget */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation Budget", meta = (AllowPrivateAccess = "true"))
+	bool bUseAnimationBudget = false;
+
+	/** Use update rate optimisation instead when the budget allocator is not used */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation Budget", meta = (AllowPrivateAccess = "true", EditCondition = "!bUseAnimationBudget"))
+	bool bUseUpdateRateOptimizations = false;
+
+	/** Distance from the nearest local view at which significance has halved */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation Budget", meta = (AllowPrivateAccess = "true"))
+	float AnimationSignificanceDistance = 2000.f;
+
+	/** Significance multiplier for climbers hanging still on a wall */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation Budget", meta = (AllowPrivateAccess = "true"))
+	float IdleClimbSignificanceScale = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation Budget", meta = (AllowPrivateAccess = "true"))
+	float AnimationSignificanceInterval = 0.2f;
+
+	FTimerHandle AnimationSignificanceTimerHandle;
+
+	bool bRegisteredWithAnimationBudget = false;
+#pragma endregion
+
 protected:
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -106,6 +140,8 @@ protected:
 	// To add mapping context
 	virtual void BeginPlay();
 
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
 public:
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
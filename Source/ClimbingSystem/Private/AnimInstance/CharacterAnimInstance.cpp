@@ -4,7 +4,6 @@
 #include "AnimInstance/CharacterAnimInstance.h"
 #include "ClimbingSystem/ClimbingSystemCharacter.h"
 #include "Components/CustomMovementComponent.h"
-#include "Kismet/KismetMathLibrary.h"
 
 #pragma region OverridenFunctions
 void UCharacterAnimInstance::NativeInitializeAnimation()
@@ -19,9 +18,10 @@ void UCharacterAnimInstance::NativeInitializeAnimation()
 	}
 }
 
-void UCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+//Only reads the snapshot the movement component wrote at the end of its tick, the mesh ticks after movement
+void UCharacterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
 {
-	Super::NativeUpdateAnimation(DeltaSeconds);
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
 	if (!ClimbingSystemCharacter || !CustomMovementComponent) return;
 
@@ -31,38 +31,44 @@ void UCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 	GetIsFalling();
 	GetIsClimbing();
 	GetClimbVelocity();
+	GetAvailableHops();
 }
 #pragma endregion
 
 void UCharacterAnimInstance::GetGroundSpeed()
 {
-	GroundSpeed = UKismetMathLibrary::VSizeXY(ClimbingSystemCharacter->GetVelocity());
+	GroundSpeed = CustomMovementComponent->GetClimbAnimSnapshot().Velocity.Size2D();
 }
 
 void UCharacterAnimInstance::GetAirSpeed()
 {
-	AirSpeed = ClimbingSystemCharacter->GetVelocity().Z;
+	AirSpeed = CustomMovementComponent->GetClimbAnimSnapshot().Velocity.Z;
 }
 
 void UCharacterAnimInstance::GetShouldMove()
 {
 	bShouldMove = 
-		CustomMovementComponent->GetCurrentAcceleration().Size() > 0 &&
+		CustomMovementComponent->GetClimbAnimSnapshot().Acceleration.Size() > 0 &&
 		GroundSpeed > 5.f &&
 		!bIsFalling;
 }
 
 void UCharacterAnimInstance::GetIsFalling()
 {
-	bIsFalling = CustomMovementComponent->IsFalling();
+	bIsFalling = CustomMovementComponent->GetClimbAnimSnapshot().bIsFalling;
 }
 
 void UCharacterAnimInstance::GetIsClimbing()
 {
-	bIsClimbing = CustomMovementComponent->IsClimbing();
+	bIsClimbing = CustomMovementComponent->GetClimbAnimSnapshot().bIsClimbing;
 }
 
 void UCharacterAnimInstance::GetClimbVelocity()
 {
-	ClimbVelocity = CustomMovementComponent->GetUnrotatedClimbVelocity();
+	ClimbVelocity = CustomMovementComponent->GetClimbAnimSnapshot().UnrotatedClimbVelocity;
+}
+
+void UCharacterAnimInstance::GetAvailableHops()
+{
+	AvailableHops = CustomMovementComponent->GetClimbAnimSnapshot().AvailableHops;
 }
\ No newline at end of file
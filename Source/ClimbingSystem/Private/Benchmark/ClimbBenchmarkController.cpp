@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmark/ClimbBenchmarkController.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Components/CustomMovementComponent.h"
+
+AClimbBenchmarkController::AClimbBenchmarkController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+}
+
+const TArray<FClimbBenchmarkStep>& AClimbBenchmarkController::GetScript()
+{
+	static const TArray<FClimbBenchmarkStep> Script = {
+		{ FVector2D::ZeroVector, EClimbBenchmarkAction::ResetToWall, 0.2f },
+		{ FVector2D(0.f, 1.f), EClimbBenchmarkAction::None, 0.6f },
+		{ FVector2D::ZeroVector, EClimbBenchmarkAction::StartClimb, 1.5f },
+		{ FVector2D(0.f, 1.f), EClimbBenchmarkAction::None, 1.f },
+		{ FVector2D(0.f, 1.f), EClimbBenchmarkAction::Hop, 1.5f },
+		{ FVector2D(1.f, 0.f), EClimbBenchmarkAction::None, 1.f },
+		{ FVector2D(1.f, 0.f), EClimbBenchmarkAction::Hop, 1.5f },
+		{ FVector2D(-1.f, 0.f), EClimbBenchmarkAction::None, 1.f },
+		{ FVector2D(-1.f, 0.f), EClimbBenchmarkAction::Hop, 1.5f },
+		{ FVector2D(0.f, -1.f), EClimbBenchmarkAction::None, 0.5f },
+		{ FVector2D(0.f, -1.f), EClimbBenchmarkAction::Hop, 1.5f },
+		{ FVector2D::ZeroVector, EClimbBenchmarkAction::None, 1.f },
+		//Long enough to reach the ledge and play the climb to top montage
+		{ FVector2D(0.f, 1.f), EClimbBenchmarkAction::None, 6.f },
+		{ FVector2D::ZeroVector, EClimbBenchmarkAction::StopClimb, 0.5f },
+		{ FVector2D::ZeroVector, EClimbBenchmarkAction::ResetToVaultBox, 0.2f },
+		{ FVector2D(0.f, 1.f), EClimbBenchmarkAction::None, 0.3f },
+		{ FVector2D::ZeroVector, EClimbBenchmarkAction::StartClimb, 2.5f }
+	};
+
+	return Script;
+}
+
+void AClimbBenchmarkController::InitLane(const FTransform& InWallStart, const FTransform& InVaultStart, float InScriptTimeOffset)
+{
+	WallStart = InWallStart;
+	VaultStart = InVaultStart;
+
+	//Staggers the climbers so they do not all transition on the same frame
+	StepIndex = INDEX_NONE;
+	StepTimeRemaining = InScriptTimeOffset;
+}
+
+void AClimbBenchmarkController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!GetPawn()) return;
+
+	const TArray<FClimbBenchmarkStep>& Script = GetScript();
+
+	StepTimeRemaining -= DeltaSeconds;
+	if (StepTimeRemaining <= 0.f)
+	{
+		StepIndex = (StepIndex + 1) % Script.Num();
+		StepTimeRemaining += Script[StepIndex].Duration;
+
+		BeginStep(Script[StepIndex]);
+	}
+
+	if (StepIndex != INDEX_NONE)
+	{
+		ApplyMoveInput(Script[StepIndex].MoveInput);
+	}
+}
+
+void AClimbBenchmarkController::BeginStep(const FClimbBenchmarkStep& Step)
+{
+	AClimbingSystemCharacter* ClimbingCharacter = Cast<AClimbingSystemCharacter>(GetPawn());
+	UCustomMovementComponent* MovementComponent = ClimbingCharacter ? ClimbingCharacter->GetCustomMovementComponent() : nullptr;
+	if (!MovementComponent) return;
+
+	switch (Step.Action)
+	{
+	case EClimbBenchmarkAction::StartClimb:
+		MovementComponent->ToggleClimbing(true);
+		break;
+	case EClimbBenchmarkAction::StopClimb:
+		if (MovementComponent->IsClimbing())
+		{
+			MovementComponent->ToggleClimbing(false);
+		}
+		break;
+	case EClimbBenchmarkAction::Hop:
+		MovementComponent->RequestHopping();
+		break;
+	case EClimbBenchmarkAction::ResetToWall:
+		ResetTo(WallStart);
+		break;
+	case EClimbBenchmarkAction::ResetToVaultBox:
+		ResetTo(VaultStart);
+		break;
+	default:
+		break;
+	}
+}
+
+void AClimbBenchmarkController::ApplyMoveInput(const FVector2D& MoveInput)
+{
+	AClimbingSystemCharacter* ClimbingCharacter = Cast<AClimbingSystemCharacter>(GetPawn());
+	if (!ClimbingCharacter || MoveInput.IsZero()) return;
+
+	UCustomMovementComponent* MovementComponent = ClimbingCharacter->GetCustomMovementComponent();
+
+	//Same input mapping as AClimbingSystemCharacter's ground and climb movement handlers
+	FVector ForwardDirection = ClimbingCharacter->GetActorForwardVector();
+	FVector RightDirection = ClimbingCharacter->GetActorRightVector();
+
+	if (MovementComponent && MovementComponent->IsClimbing())
+	{
+		ForwardDirection = FVector::CrossProduct(-MovementComponent->GetClimbableSurfaceNormal(), ClimbingCharacter->GetActorRightVector());
+		RightDirection = FVector::CrossProduct(-MovementComponent->GetClimbableSurfaceNormal(), -ClimbingCharacter->GetActorUpVector());
+	}
+
+	ClimbingCharacter->AddMovementInput(ForwardDirection, MoveInput.Y);
+	ClimbingCharacter->AddMovementInput(RightDirection, MoveInput.X);
+}
+
+void AClimbBenchmarkController::ResetTo(const FTransform& StartTransform)
+{
+	ACharacter* Character = Cast<ACharacter>(GetPawn());
+	if (!Character) return;
+
+	Character->StopAnimMontage();
+	Character->GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+	Character->TeleportTo(StartTransform.GetLocation(), StartTransform.Rotator(), false, true);
+	SetControlRotation(StartTransform.Rotator());
+}
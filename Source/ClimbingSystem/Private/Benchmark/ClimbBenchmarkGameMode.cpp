@@ -0,0 +1,275 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmark/ClimbBenchmarkGameMode.h"
+#include "Benchmark/ClimbBenchmarkController.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Components/CustomMovementComponent.h"
+#include "Subsystems/ClimbBatchSubsystem.h"
+#include "Subsystems/ClimbQueryScheduler.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbBenchmark, Log, All);
+
+namespace ClimbBenchmark
+{
+	static double Percentile(TArray<double> Values, double Fraction)
+	{
+		if (Values.IsEmpty()) return 0.0;
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::FloorToInt(Fraction * (Values.Num() - 1)), 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	static double Mean(const TArray<double>& Values)
+	{
+		if (Values.IsEmpty()) return 0.0;
+
+		double Sum = 0.0;
+		for (const double Value : Values)
+		{
+			Sum += Value;
+		}
+		return Sum / Values.Num();
+	}
+}
+
+AClimbBenchmarkGameMode::AClimbBenchmarkGameMode()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+
+	//The benchmark has no player pawn, only scripted climbers
+	DefaultPawnClass = nullptr;
+
+	ClimberClass = TSoftClassPtr<ACharacter>(FSoftObjectPath(TEXT("/Game/ClimbSystem/BP_ClimbingSystemCharacter.BP_ClimbingSystemCharacter_C")));
+}
+
+void AClimbBenchmarkGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	FParse::Value(FCommandLine::Get(), TEXT("ClimbBenchCount="), NumClimbers);
+	FParse::Value(FCommandLine::Get(), TEXT("ClimbBenchWarmup="), NumWarmupFrames);
+	FParse::Value(FCommandLine::Get(), TEXT("ClimbBenchFrames="), NumMeasuredFrames);
+
+	NumClimbers = FMath::Max(NumClimbers, 1);
+	NumMeasuredFrames = FMath::Max(NumMeasuredFrames, 1);
+
+	BuildArena();
+	SpawnClimbers();
+
+	StartUsedPhysicalMemory = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysicalMemory = StartUsedPhysicalMemory;
+
+	UE_LOG(LogClimbBenchmark, Display, TEXT("Climb benchmark: %d climbers, %d warmup frames, %d measured frames"), Climbers.Num(), NumWarmupFrames, NumMeasuredFrames);
+}
+
+void AClimbBenchmarkGameMode::BuildArena()
+{
+	const float ArenaWidth = NumClimbers * LaneSpacing;
+
+	//Floor under every lane
+	SpawnBlock(ArenaOrigin + FVector(0.f, ArenaWidth * 0.5f - LaneSpacing * 0.5f, -50.f), FVector(2000.f, ArenaWidth + 1000.f, 100.f));
+
+	for (int32 LaneIndex = 0; LaneIndex < NumClimbers; LaneIndex++)
+	{
+		const FVector LaneOrigin = ArenaOrigin + FVector(0.f, LaneIndex * LaneSpacing, 0.f);
+
+		//Climbable wall with a walkable top, wide enough to hop sideways
+		SpawnBlock(LaneOrigin + FVector(300.f, 0.f, 300.f), FVector(60.f, 500.f, 600.f));
+
+		//Every third lane continues into a leaning overhang instead of a ledge
+		if (LaneIndex % 3 == 2)
+		{
+			SpawnBlock(LaneOrigin + FVector(280.f, 0.f, 750.f), FVector(60.f, 500.f, 300.f), FRotator(15.f, 0.f, 0.f));
+		}
+
+		//Low box behind the start for the vault run
+		SpawnBlock(LaneOrigin + FVector(-350.f, 0.f, 50.f), FVector(100.f, 200.f, 100.f));
+	}
+}
+
+void AClimbBenchmarkGameMode::SpawnBlock(const FVector& Center, const FVector& Size, const FRotator& Rotation)
+{
+	static UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!CubeMesh) return;
+
+	AStaticMeshActor* Block = GetWorld()->SpawnActor<AStaticMeshActor>(Center, Rotation);
+	if (!Block) return;
+
+	UStaticMeshComponent* BlockMesh = Block->GetStaticMeshComponent();
+	BlockMesh->SetMobility(EComponentMobility::Movable);
+	BlockMesh->SetStaticMesh(CubeMesh);
+
+	//The engine cube is 100 units across
+	Block->SetActorScale3D(Size / 100.f);
+}
+
+void AClimbBenchmarkGameMode::SpawnClimbers()
+{
+	UClass* CharacterClass = ClimberClass.LoadSynchronous();
+	if (!CharacterClass)
+	{
+		UE_LOG(LogClimbBenchmark, Warning, TEXT("Could not load %s, climbers will have no montages"), *ClimberClass.ToString());
+		CharacterClass = AClimbingSystemCharacter::StaticClass();
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (int32 LaneIndex = 0; LaneIndex < NumClimbers; LaneIndex++)
+	{
+		const FVector LaneOrigin = ArenaOrigin + FVector(0.f, LaneIndex * LaneSpacing, 0.f);
+		const FTransform WallStart(FRotator::ZeroRotator, LaneOrigin + FVector(0.f, 0.f, 100.f));
+		const FTransform VaultStart(FRotator(0.f, 180.f, 0.f), LaneOrigin + FVector(-150.f, 0.f, 100.f));
+
+		AClimbingSystemCharacter* Climber = GetWorld()->SpawnActor<AClimbingSystemCharacter>(CharacterClass, WallStart, SpawnParameters);
+		if (!Climber || !Climber->GetCustomMovementComponent()) continue;
+
+		AClimbBenchmarkController* BenchmarkController = GetWorld()->SpawnActor<AClimbBenchmarkController>();
+		BenchmarkController->InitLane(WallStart, VaultStart, 0.05f * LaneIndex);
+		BenchmarkController->Possess(Climber);
+
+		Climbers.Add(Climber->GetCustomMovementComponent());
+		PreviousQueryCounts.Add(Climber->GetCustomMovementComponent()->GetNumClimbQueriesIssued());
+	}
+}
+
+void AClimbBenchmarkGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (bFinished || Climbers.IsEmpty()) return;
+
+	RecordFrame();
+
+	if (++FrameIndex >= NumWarmupFrames + NumMeasuredFrames)
+	{
+		FinishBenchmark();
+	}
+}
+
+void AClimbBenchmarkGameMode::RecordFrame()
+{
+	uint64 MovementTickCycles = 0;
+	int32 QueriesThisFrame = 0;
+
+	for (int32 ClimberIndex = 0; ClimberIndex < Climbers.Num(); ClimberIndex++)
+	{
+		const UCustomMovementComponent* Climber = Climbers[ClimberIndex];
+		if (!IsValid(Climber)) continue;
+
+		MovementTickCycles += Climber->GetLastMovementTickCycles();
+
+		const int32 QueryCount = Climber->GetNumClimbQueriesIssued();
+		QueriesThisFrame += QueryCount - PreviousQueryCounts[ClimberIndex];
+		PreviousQueryCounts[ClimberIndex] = QueryCount;
+	}
+
+	//Batched AI steps and deferred queries run from the subsystems' ticks, outside every climber's TickComponent
+	if (const UClimbBatchSubsystem* BatchSubsystem = GetWorld()->GetSubsystem<UClimbBatchSubsystem>())
+	{
+		MovementTickCycles += BatchSubsystem->GetLastTickCycles();
+	}
+
+	if (const UClimbQueryScheduler* QueryScheduler = GetWorld()->GetSubsystem<UClimbQueryScheduler>())
+	{
+		MovementTickCycles += QueryScheduler->GetLastTickCycles();
+	}
+
+	if (FrameIndex < NumWarmupFrames) return;
+
+	FrameMovementTickMs.Add(FPlatformTime::ToMilliseconds64(MovementTickCycles));
+	FrameQueriesPerClimber.Add((double)QueriesThisFrame / Climbers.Num());
+
+	PeakUsedPhysicalMemory = FMath::Max<uint64>(PeakUsedPhysicalMemory, FPlatformMemory::GetStats().UsedPhysical);
+}
+
+void AClimbBenchmarkGameMode::FinishBenchmark()
+{
+	bFinished = true;
+
+	const double MeanTickMs = ClimbBenchmark::Mean(FrameMovementTickMs);
+	const double MeanQueries = ClimbBenchmark::Mean(FrameQueriesPerClimber);
+	const double MemoryGrowthMb = ((double)FPlatformMemory::GetStats().UsedPhysical - (double)StartUsedPhysicalMemory) / (1024.0 * 1024.0);
+
+	TSharedRef<FJsonObject> TickObject = MakeShared<FJsonObject>();
+	TickObject->SetNumberField(TEXT("mean"), MeanTickMs);
+	TickObject->SetNumberField(TEXT("p50"), ClimbBenchmark::Percentile(FrameMovementTickMs, 0.5));
+	TickObject->SetNumberField(TEXT("p95"), ClimbBenchmark::Percentile(FrameMovementTickMs, 0.95));
+	TickObject->SetNumberField(TEXT("max"), ClimbBenchmark::Percentile(FrameMovementTickMs, 1.0));
+
+	TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+	ResultObject->SetNumberField(TEXT("climbers"), Climbers.Num());
+	ResultObject->SetNumberField(TEXT("frames"), FrameMovementTickMs.Num());
+	ResultObject->SetObjectField(TEXT("movement_tick_ms"), TickObject);
+	ResultObject->SetNumberField(TEXT("movement_tick_ms_per_climber"), MeanTickMs / Climbers.Num());
+	ResultObject->SetNumberField(TEXT("queries_per_climber_per_frame"), MeanQueries);
+	ResultObject->SetNumberField(TEXT("memory_growth_mb"), MemoryGrowthMb);
+	ResultObject->SetNumberField(TEXT("peak_memory_growth_mb"), ((double)PeakUsedPhysicalMemory - (double)StartUsedPhysicalMemory) / (1024.0 * 1024.0));
+
+	uint8 ExitCode = 0;
+
+	FString BaselinePath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("ClimbBenchBaseline="), BaselinePath))
+	{
+		float Tolerance = 0.1f;
+		FParse::Value(FCommandLine::Get(), TEXT("ClimbBenchTolerance="), Tolerance);
+
+		FString BaselineText;
+		TSharedPtr<FJsonObject> BaselineObject;
+
+		if (FFileHelper::LoadFileToString(BaselineText, *BaselinePath) &&
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), BaselineObject) && BaselineObject.IsValid())
+		{
+			const double BaselineTickMs = BaselineObject->GetNumberField(TEXT("movement_tick_ms_per_climber"));
+			const double BaselineQueries = BaselineObject->GetNumberField(TEXT("queries_per_climber_per_frame"));
+
+			const double TickRatio = BaselineTickMs > 0.0 ? (MeanTickMs / Climbers.Num()) / BaselineTickMs : 1.0;
+			const double QueryRatio = BaselineQueries > 0.0 ? MeanQueries / BaselineQueries : 1.0;
+			const bool bRegressed = TickRatio > 1.0 + Tolerance || QueryRatio > 1.0 + Tolerance;
+
+			TSharedRef<FJsonObject> ComparisonObject = MakeShared<FJsonObject>();
+			ComparisonObject->SetStringField(TEXT("path"), BaselinePath);
+			ComparisonObject->SetNumberField(TEXT("movement_tick_ratio"), TickRatio);
+			ComparisonObject->SetNumberField(TEXT("queries_ratio"), QueryRatio);
+			ComparisonObject->SetBoolField(TEXT("regressed"), bRegressed);
+			ResultObject->SetObjectField(TEXT("baseline"), ComparisonObject);
+
+			UE_LOG(LogClimbBenchmark, Display, TEXT("Against baseline: movement tick x%.3f, queries x%.3f"), TickRatio, QueryRatio);
+
+			if (bRegressed)
+			{
+				UE_LOG(LogClimbBenchmark, Error, TEXT("Climbing regressed past the %.0f%% tolerance"), Tolerance * 100.f);
+				ExitCode = 1;
+			}
+		}
+		else
+		{
+			UE_LOG(LogClimbBenchmark, Warning, TEXT("Could not read baseline %s"), *BaselinePath);
+		}
+	}
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("ClimbBenchmark") / TEXT("ClimbBenchmark.json");
+	FParse::Value(FCommandLine::Get(), TEXT("ClimbBenchOutput="), OutputPath);
+
+	FString OutputText;
+	FJsonSerializer::Serialize(ResultObject, TJsonWriterFactory<>::Create(&OutputText));
+	FFileHelper::SaveStringToFile(OutputText, *OutputPath);
+
+	UE_LOG(LogClimbBenchmark, Display, TEXT("Movement tick %.3f ms/frame (%.4f ms per climber), %.2f queries per climber per frame. Written to %s"),
+		MeanTickMs, MeanTickMs / Climbers.Num(), MeanQueries, *OutputPath);
+
+	FPlatformMisc::RequestExitWithStatus(false, ExitCode);
+}
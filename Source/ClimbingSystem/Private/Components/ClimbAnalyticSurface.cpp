@@ -0,0 +1,266 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbAnalyticSurface.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace ClimbAnalyticSurface
+{
+	//Convex hulls with more faces than this are cheaper to trace than to test plane by plane
+	constexpr int32 MaxPlanes = 32;
+
+	//Segments have to reach this far into the collision to count as a hit, so edges still go to a trace
+	constexpr float HitTolerance = 1.f;
+
+	//Faces closer to parallel than this never meet the face being climbed
+	constexpr float MinEdgeSine = 0.01f;
+
+	//Same slope a floor hit needs to count as a floor
+	constexpr float MinBottomFacing = 0.7f;
+}
+
+bool FClimbAnalyticSurface::Build(UPrimitiveComponent& InPrimitive, FName PlanarTag)
+{
+	Reset();
+
+	const UBodySetup* BodySetup = InPrimitive.GetBodySetup();
+
+	if (!PlanarTag.IsNone() && InPrimitive.ComponentHasTag(PlanarTag))
+	{
+		//Flagged components promise their collision fills their bounds, e.g. a flat wall panel with complex collision
+		AddLocalBox(InPrimitive.CalcBounds(FTransform::Identity).GetBox(), FTransform::Identity);
+	}
+	else if (BodySetup && BodySetup->GetCollisionTraceFlag() != CTF_UseComplexAsSimple && BodySetup->AggGeom.GetElementCount() == 1)
+	{
+		const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+
+		if (AggGeom.BoxElems.Num() == 1)
+		{
+			const FKBoxElem& BoxElem = AggGeom.BoxElems[0];
+			const FVector HalfExtent(BoxElem.X * 0.5f, BoxElem.Y * 0.5f, BoxElem.Z * 0.5f);
+
+			AddLocalBox(FBox(-HalfExtent, HalfExtent), BoxElem.GetTransform());
+		}
+		else if (AggGeom.ConvexElems.Num() == 1)
+		{
+			const FKConvexElem& ConvexElem = AggGeom.ConvexElems[0];
+			const FTransform ElemTransform = ConvexElem.GetTransform();
+
+			if (ConvexElem.VertexData.IsEmpty() || ConvexElem.IndexData.Num() < 3) return false;
+
+			FVector InteriorPoint = FVector::ZeroVector;
+			for (const FVector& Vertex : ConvexElem.VertexData)
+			{
+				InteriorPoint += ElemTransform.TransformPosition(Vertex);
+			}
+			InteriorPoint /= ConvexElem.VertexData.Num();
+
+			for (int32 Index = 0; Index + 2 < ConvexElem.IndexData.Num(); Index += 3)
+			{
+				const FVector A = ElemTransform.TransformPosition(ConvexElem.VertexData[ConvexElem.IndexData[Index]]);
+				const FVector B = ElemTransform.TransformPosition(ConvexElem.VertexData[ConvexElem.IndexData[Index + 1]]);
+				const FVector C = ElemTransform.TransformPosition(ConvexElem.VertexData[ConvexElem.IndexData[Index + 2]]);
+
+				const FVector Normal = FVector::CrossProduct(B - A, C - A).GetSafeNormal();
+				if (Normal.IsZero()) continue;
+
+				//Winding is not guaranteed, face every plane away from the hull interior
+				FPlane Plane(A, Normal);
+				if (Plane.PlaneDot(InteriorPoint) > 0.f) Plane = Plane.Flip();
+
+				AddLocalPlane(Plane);
+
+				if (LocalPlanes.Num() > ClimbAnalyticSurface::MaxPlanes)
+				{
+					Reset();
+					return false;
+				}
+			}
+		}
+	}
+
+	//A closed convex needs at least four faces
+	if (LocalPlanes.Num() < 4)
+	{
+		Reset();
+		return false;
+	}
+
+	Primitive = &InPrimitive;
+	UpdateWorldPlanes();
+
+	return true;
+}
+
+void FClimbAnalyticSurface::Reset()
+{
+	Primitive.Reset();
+	LocalPlanes.Reset();
+	WorldPlanes.Reset();
+}
+
+bool FClimbAnalyticSurface::Refresh()
+{
+	const UPrimitiveComponent* CurrentPrimitive = Primitive.Get();
+	if (!CurrentPrimitive || WorldPlanes.IsEmpty()) return false;
+
+	if (!CurrentPrimitive->GetComponentTransform().Equals(PlanesTransform))
+	{
+		UpdateWorldPlanes();
+	}
+
+	return true;
+}
+
+bool FClimbAnalyticSurface::FindSurface(const FVector& Location, float EdgeMargin, FVector& OutSurfaceLocation, FVector& OutSurfaceNormal) const
+{
+	//Outside a convex the face the location is furthest in front of is the one it faces
+	int32 FaceIndex = INDEX_NONE;
+	double FaceDistance = 0.0;
+
+	for (int32 PlaneIndex = 0; PlaneIndex < WorldPlanes.Num(); PlaneIndex++)
+	{
+		const double Distance = WorldPlanes[PlaneIndex].PlaneDot(Location);
+		if (Distance > FaceDistance)
+		{
+			FaceDistance = Distance;
+			FaceIndex = PlaneIndex;
+		}
+	}
+
+	if (FaceIndex == INDEX_NONE) return false;
+
+	const FVector FaceNormal(WorldPlanes[FaceIndex]);
+	const FVector SurfaceLocation = Location - FaceNormal * FaceDistance;
+
+	//Distance to each neighbouring face measured along the climbed face, i.e. how far the edge is
+	for (int32 PlaneIndex = 0; PlaneIndex < WorldPlanes.Num(); PlaneIndex++)
+	{
+		if (PlaneIndex == FaceIndex) continue;
+
+		const FPlane& Plane = WorldPlanes[PlaneIndex];
+		const double EdgeSine = FMath::Sqrt(FMath::Max(0.0, 1.0 - FMath::Square(FVector::DotProduct(FVector(Plane), FaceNormal))));
+		if (EdgeSine < ClimbAnalyticSurface::MinEdgeSine) continue;
+
+		if (-Plane.PlaneDot(SurfaceLocation) < EdgeMargin * EdgeSine) return false;
+	}
+
+	OutSurfaceLocation = SurfaceLocation;
+	OutSurfaceNormal = FaceNormal;
+	return true;
+}
+
+bool FClimbAnalyticSurface::IntersectsSegment(const FVector& Start, const FVector& End) const
+{
+	if (WorldPlanes.IsEmpty()) return false;
+
+	const FVector Delta = End - Start;
+
+	//Clip the segment against every face of a slightly shrunk hull
+	double EnterTime = 0.0;
+	double ExitTime = 1.0;
+	bool bStartsOutside = false;
+
+	for (const FPlane& Plane : WorldPlanes)
+	{
+		const double StartDistance = Plane.PlaneDot(Start) + ClimbAnalyticSurface::HitTolerance;
+		const double Approach = FVector::DotProduct(FVector(Plane), Delta);
+
+		bStartsOutside |= StartDistance > 0.0;
+
+		if (FMath::IsNearlyZero(Approach))
+		{
+			if (StartDistance > 0.0) return false;
+			continue;
+		}
+
+		const double CrossTime = -StartDistance / Approach;
+
+		if (Approach < 0.0)
+		{
+			EnterTime = FMath::Max(EnterTime, CrossTime);
+		}
+		else
+		{
+			ExitTime = FMath::Min(ExitTime, CrossTime);
+		}
+
+		if (EnterTime > ExitTime) return false;
+	}
+
+	return bStartsOutside;
+}
+
+bool FClimbAnalyticSurface::FindBottomFaceDistance(const FVector& Location, const FVector& Direction, float& OutDistance) const
+{
+	bool bFound = false;
+	OutDistance = MAX_flt;
+
+	for (const FPlane& Plane : WorldPlanes)
+	{
+		//Only faces turned towards the direction can be what the collision rests on
+		const double Facing = FVector::DotProduct(FVector(Plane), Direction);
+		if (Facing < ClimbAnalyticSurface::MinBottomFacing) continue;
+
+		const double Distance = -Plane.PlaneDot(Location) / Facing;
+		if (Distance < 0.0) continue;
+
+		OutDistance = FMath::Min(OutDistance, (float)Distance);
+		bFound = true;
+	}
+
+	return bFound;
+}
+
+void FClimbAnalyticSurface::AddLocalPlane(const FPlane& Plane)
+{
+	//Triangulated hull faces come in pairs or fans, keep one plane per face
+	for (const FPlane& ExistingPlane : LocalPlanes)
+	{
+		if (FVector::DotProduct(FVector(ExistingPlane), FVector(Plane)) > 0.9999 && FMath::IsNearlyEqual(ExistingPlane.W, Plane.W, 0.1))
+		{
+			return;
+		}
+	}
+
+	LocalPlanes.Add(Plane);
+}
+
+void FClimbAnalyticSurface::AddLocalBox(const FBox& Box, const FTransform& BoxTransform)
+{
+	if (!Box.IsValid) return;
+
+	const FVector Axes[] = { FVector::XAxisVector, FVector::YAxisVector, FVector::ZAxisVector };
+	const FVector MaxPoint = BoxTransform.TransformPosition(Box.Max);
+	const FVector MinPoint = BoxTransform.TransformPosition(Box.Min);
+
+	for (int32 AxisIndex = 0; AxisIndex < 3; AxisIndex++)
+	{
+		const FVector AxisNormal = BoxTransform.TransformVectorNoScale(Axes[AxisIndex]);
+
+		AddLocalPlane(FPlane(MaxPoint, AxisNormal));
+		AddLocalPlane(FPlane(MinPoint, -AxisNormal));
+	}
+}
+
+void FClimbAnalyticSurface::UpdateWorldPlanes()
+{
+	const UPrimitiveComponent* CurrentPrimitive = Primitive.Get();
+	if (!CurrentPrimitive) return;
+
+	PlanesTransform = CurrentPrimitive->GetComponentTransform();
+
+	//Normals take the inverse scale so the planes stay exact under non-uniform component scale
+	const FVector InverseScale = PlanesTransform.GetSafeScaleReciprocal(PlanesTransform.GetScale3D());
+
+	WorldPlanes.Reset();
+	for (const FPlane& LocalPlane : LocalPlanes)
+	{
+		const FVector LocalNormal(LocalPlane);
+		const FVector WorldPoint = PlanesTransform.TransformPosition(LocalNormal * LocalPlane.W);
+		const FVector WorldNormal = PlanesTransform.GetRotation().RotateVector(LocalNormal * InverseScale).GetSafeNormal();
+
+		WorldPlanes.Add(FPlane(WorldPoint, WorldNormal));
+	}
+}
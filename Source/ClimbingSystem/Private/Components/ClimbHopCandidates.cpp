@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbHopCandidates.h"
+#include "Math/VectorRegister.h"
+
+void FClimbHopCandidates::Reset(const FVector& InOrigin)
+{
+	Origin = InOrigin;
+	NumCandidates = 0;
+
+	PositionX.Reset();
+	PositionY.Reset();
+	PositionZ.Reset();
+	NormalX.Reset();
+	NormalY.Reset();
+	NormalZ.Reset();
+	Gaps.Reset();
+}
+
+void FClimbHopCandidates::Add(const FVector& Position, const FVector& Normal, float Gap)
+{
+	//Open a new group of four lanes, the padding ones can never pass the gap test
+	if (NumCandidates % LaneWidth == 0)
+	{
+		PositionX.AddZeroed(LaneWidth);
+		PositionY.AddZeroed(LaneWidth);
+		PositionZ.AddZeroed(LaneWidth);
+		NormalX.AddZeroed(LaneWidth);
+		NormalY.AddZeroed(LaneWidth);
+		NormalZ.AddZeroed(LaneWidth);
+
+		for (int32 LaneIndex = 0; LaneIndex < LaneWidth; LaneIndex++)
+		{
+			Gaps.Add(MAX_flt);
+		}
+	}
+
+	const FVector RelativePosition = Position - Origin;
+
+	PositionX[NumCandidates] = (float)RelativePosition.X;
+	PositionY[NumCandidates] = (float)RelativePosition.Y;
+	PositionZ[NumCandidates] = (float)RelativePosition.Z;
+	NormalX[NumCandidates] = (float)Normal.X;
+	NormalY[NumCandidates] = (float)Normal.Y;
+	NormalZ[NumCandidates] = (float)Normal.Z;
+	Gaps[NumCandidates] = Gap;
+
+	NumCandidates++;
+}
+
+int32 FClimbHopCandidates::FindBest(const FClimbHopScoring& Scoring) const
+{
+	if (NumCandidates == 0) return INDEX_NONE;
+
+	const VectorRegister4Float IdealX = VectorSetFloat1((float)Scoring.IdealTarget.X);
+	const VectorRegister4Float IdealY = VectorSetFloat1((float)Scoring.IdealTarget.Y);
+	const VectorRegister4Float IdealZ = VectorSetFloat1((float)Scoring.IdealTarget.Z);
+	const VectorRegister4Float SurfaceNormalX = VectorSetFloat1((float)Scoring.SurfaceNormal.X);
+	const VectorRegister4Float SurfaceNormalY = VectorSetFloat1((float)Scoring.SurfaceNormal.Y);
+	const VectorRegister4Float SurfaceNormalZ = VectorSetFloat1((float)Scoring.SurfaceNormal.Z);
+
+	const VectorRegister4Float InvReach = VectorSetFloat1(1.f / FMath::Max(Scoring.Reach, UE_KINDA_SMALL_NUMBER));
+	const VectorRegister4Float InvMaxGap = VectorSetFloat1(1.f / FMath::Max(Scoring.MaxGap, UE_KINDA_SMALL_NUMBER));
+	const VectorRegister4Float MaxGap = VectorSetFloat1(Scoring.MaxGap);
+	const VectorRegister4Float MinNormalDot = VectorSetFloat1(Scoring.MinNormalDot);
+	const VectorRegister4Float DistanceWeight = VectorSetFloat1(Scoring.DistanceWeight);
+	const VectorRegister4Float AngleWeight = VectorSetFloat1(Scoring.AngleWeight);
+	const VectorRegister4Float ReachWeight = VectorSetFloat1(Scoring.ReachWeight);
+	const VectorRegister4Float Rejected = VectorSetFloat1(-MAX_flt);
+
+	MS_ALIGN(16) float LaneScores[4] GCC_ALIGN(16);
+
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = -MAX_flt;
+
+	const int32 PaddedNum = PositionX.Num();
+	for (int32 LaneIndex = 0; LaneIndex < PaddedNum; LaneIndex += LaneWidth)
+	{
+		const VectorRegister4Float DeltaX = VectorSubtract(VectorLoadAligned(&PositionX[LaneIndex]), IdealX);
+		const VectorRegister4Float DeltaY = VectorSubtract(VectorLoadAligned(&PositionY[LaneIndex]), IdealY);
+		const VectorRegister4Float DeltaZ = VectorSubtract(VectorLoadAligned(&PositionZ[LaneIndex]), IdealZ);
+		const VectorRegister4Float Distance = VectorSqrt(VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ))));
+
+		const VectorRegister4Float NormalDot = VectorMultiplyAdd(VectorLoadAligned(&NormalX[LaneIndex]), SurfaceNormalX,
+			VectorMultiplyAdd(VectorLoadAligned(&NormalY[LaneIndex]), SurfaceNormalY,
+			VectorMultiply(VectorLoadAligned(&NormalZ[LaneIndex]), SurfaceNormalZ)));
+
+		const VectorRegister4Float Gap = VectorLoadAligned(&Gaps[LaneIndex]);
+
+		//Closer to the input, same facing as the current surface and a short reach all score higher
+		VectorRegister4Float Score = VectorMultiply(DistanceWeight, VectorSubtract(VectorOneFloat(), VectorMultiply(Distance, InvReach)));
+		Score = VectorMultiplyAdd(AngleWeight, NormalDot, Score);
+		Score = VectorMultiplyAdd(ReachWeight, VectorSubtract(VectorOneFloat(), VectorMultiply(Gap, InvMaxGap)), Score);
+
+		const VectorRegister4Float Valid = VectorBitwiseAnd(VectorCompareGE(NormalDot, MinNormalDot), VectorCompareLE(Gap, MaxGap));
+		VectorStoreAligned(VectorSelect(Valid, Score, Rejected), LaneScores);
+
+		for (int32 Lane = 0; Lane < LaneWidth; Lane++)
+		{
+			if (LaneScores[Lane] > BestScore)
+			{
+				BestScore = LaneScores[Lane];
+				BestIndex = LaneIndex + Lane;
+			}
+		}
+	}
+
+	return BestIndex;
+}
@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbNetworkPrediction.h"
+#include "Components/CustomMovementComponent.h"
+#include "GameFramework/Character.h"
+
+#pragma region SavedMove
+void FSavedMove_Climb::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToStartClimbing = false;
+	bSavedWantsToStopClimbing = false;
+	bSavedWantsToHop = false;
+	bSavedIsClimbing = false;
+	SavedClimbSurfaceLocation = FVector::ZeroVector;
+	SavedClimbSurfaceNormal = FVector::ZeroVector;
+	SavedClimbStepAccumulator = 0.f;
+	SavedFilteredClimbSurfaceNormal = FVector::ZeroVector;
+	SavedFilteredClimbSurfaceAnchor = FVector::ZeroVector;
+	bSavedHasFilteredClimbSurface = false;
+}
+
+uint8 FSavedMove_Climb::GetCompressedFlags() const
+{
+	uint8 Result = Super::GetCompressedFlags();
+
+	if (bSavedWantsToStartClimbing) Result |= ClimbMoveFlags::StartClimb;
+	if (bSavedWantsToStopClimbing) Result |= ClimbMoveFlags::StopClimb;
+	if (bSavedWantsToHop) Result |= ClimbMoveFlags::Hop;
+
+	return Result;
+}
+
+bool FSavedMove_Climb::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	const FSavedMove_Climb* NewClimbMove = static_cast<const FSavedMove_Climb*>(NewMove.Get());
+
+	//Requests are one-shot, never merge them away
+	if (bSavedWantsToStartClimbing || bSavedWantsToStopClimbing || bSavedWantsToHop) return false;
+	if (NewClimbMove->bSavedWantsToStartClimbing || NewClimbMove->bSavedWantsToStopClimbing || NewClimbMove->bSavedWantsToHop) return false;
+
+	//A combined move would split into different fixed steps on the server than it did on the client
+	const UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(InCharacter->GetCharacterMovement());
+	if (MovementComponent && MovementComponent->bUseFixedClimbStep && (bSavedIsClimbing || NewClimbMove->bSavedIsClimbing)) return false;
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Climb::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	if (const UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(C->GetCharacterMovement()))
+	{
+		bSavedWantsToStartClimbing = MovementComponent->bWantsToStartClimbing;
+		bSavedWantsToStopClimbing = MovementComponent->bWantsToStopClimbing;
+		bSavedWantsToHop = MovementComponent->bWantsToHop;
+		SavedClimbStepAccumulator = MovementComponent->ClimbStepAccumulator;
+		SavedFilteredClimbSurfaceNormal = MovementComponent->FilteredClimbSurfaceNormal;
+		SavedFilteredClimbSurfaceAnchor = MovementComponent->FilteredClimbSurfaceAnchor;
+		bSavedHasFilteredClimbSurface = MovementComponent->bHasFilteredClimbSurface;
+	}
+}
+
+void FSavedMove_Climb::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
+{
+	Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+	//The combined move is resimulated from where the old one started, filter state included
+	const FSavedMove_Climb* OldClimbMove = static_cast<const FSavedMove_Climb*>(OldMove);
+	SavedFilteredClimbSurfaceNormal = OldClimbMove->SavedFilteredClimbSurfaceNormal;
+	SavedFilteredClimbSurfaceAnchor = OldClimbMove->SavedFilteredClimbSurfaceAnchor;
+	bSavedHasFilteredClimbSurface = OldClimbMove->bSavedHasFilteredClimbSurface;
+
+	if (UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(InCharacter->GetCharacterMovement()))
+	{
+		MovementComponent->FilteredClimbSurfaceNormal = SavedFilteredClimbSurfaceNormal;
+		MovementComponent->FilteredClimbSurfaceAnchor = SavedFilteredClimbSurfaceAnchor;
+		MovementComponent->bHasFilteredClimbSurface = bSavedHasFilteredClimbSurface;
+	}
+}
+
+void FSavedMove_Climb::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	//Replays only re-simulate movement, the requests already ran when the move was first made
+	if (UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(C->GetCharacterMovement()))
+	{
+		MovementComponent->bWantsToStartClimbing = false;
+		MovementComponent->bWantsToStopClimbing = false;
+		MovementComponent->bWantsToHop = false;
+		MovementComponent->ClimbSurfaceCache.bValid = false;
+		MovementComponent->ClimbStepAccumulator = SavedClimbStepAccumulator;
+		MovementComponent->FilteredClimbSurfaceNormal = SavedFilteredClimbSurfaceNormal;
+		MovementComponent->FilteredClimbSurfaceAnchor = SavedFilteredClimbSurfaceAnchor;
+		MovementComponent->bHasFilteredClimbSurface = bSavedHasFilteredClimbSurface;
+	}
+}
+
+void FSavedMove_Climb::PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode)
+{
+	Super::PostUpdate(C, PostUpdateMode);
+
+	if (const UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(C->GetCharacterMovement()))
+	{
+		bSavedIsClimbing = MovementComponent->IsClimbing();
+		SavedClimbSurfaceLocation = MovementComponent->CurrentClimbableSurfaceLocation;
+		SavedClimbSurfaceNormal = MovementComponent->CurrentClimbableSurfaceNormal;
+	}
+}
+#pragma endregion
+
+#pragma region PredictionData
+FNetworkPredictionData_Client_Climb::FNetworkPredictionData_Client_Climb(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Climb::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_Climb());
+}
+#pragma endregion
+
+#pragma region MoveData
+void FClimbNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_Climb& ClimbMove = static_cast<const FSavedMove_Climb&>(ClientMove);
+
+	bIsClimbing = ClimbMove.bSavedIsClimbing;
+	ClimbSurfaceLocation = ClimbMove.SavedClimbSurfaceLocation;
+	ClimbSurfaceNormal = ClimbMove.SavedClimbSurfaceNormal;
+}
+
+bool FClimbNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	//One bit when not climbing, quantized surface frame otherwise
+	Ar.SerializeBits(&bIsClimbing, 1);
+
+	if (bIsClimbing)
+	{
+		bool bLocationSuccess = true;
+		bool bNormalSuccess = true;
+
+		ClimbSurfaceLocation.NetSerialize(Ar, PackageMap, bLocationSuccess);
+		ClimbSurfaceNormal.NetSerialize(Ar, PackageMap, bNormalSuccess);
+	}
+
+	return !Ar.IsError();
+}
+
+FClimbNetworkMoveDataContainer::FClimbNetworkMoveDataContainer()
+{
+	NewMoveData = &ClimbDefaultMoveData[0];
+	PendingMoveData = &ClimbDefaultMoveData[1];
+	OldMoveData = &ClimbDefaultMoveData[2];
+}
+#pragma endregion
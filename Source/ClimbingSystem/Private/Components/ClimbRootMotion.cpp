@@ -0,0 +1,218 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbRootMotion.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/ClimbTransitionEvent.h"
+#include "Animation/AnimMontage.h"
+#include "AnimNotifyState_MotionWarping.h"
+#include "RootMotionModifier.h"
+#include "GameFramework/Character.h"
+#include "Engine/NetSerialization.h"
+
+#pragma region Track
+void FClimbRootMotionTrack::Bake(const UAnimMontage& Montage, float InSampleRate)
+{
+	SampleRate = FMath::Max(InSampleRate, 1.f);
+	PlayLength = Montage.GetPlayLength();
+	BlendOutTime = FMath::Clamp(Montage.GetDefaultBlendOutTime(), 0.f, PlayLength);
+
+	const int32 NumSamples = FMath::CeilToInt32(PlayLength * SampleRate) + 1;
+	Translations.SetNum(NumSamples);
+	Distances.SetNum(NumSamples);
+
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; SampleIndex++)
+	{
+		const float Time = FMath::Min(SampleIndex / SampleRate, PlayLength);
+		Translations[SampleIndex] = FVector3f(Montage.ExtractRootMotionFromTrackRange(0.f, Time).GetTranslation());
+		Distances[SampleIndex] = SampleIndex == 0 ? 0.f : Distances[SampleIndex - 1] + FVector3f::Dist(Translations[SampleIndex], Translations[SampleIndex - 1]);
+	}
+
+	WarpWindows.Reset();
+
+	for (const FAnimNotifyEvent& NotifyEvent : Montage.Notifies)
+	{
+		const UAnimNotifyState_MotionWarping* WarpNotify = Cast<UAnimNotifyState_MotionWarping>(NotifyEvent.NotifyStateClass);
+		const URootMotionModifier_Warp* WarpModifier = WarpNotify ? Cast<URootMotionModifier_Warp>(WarpNotify->RootMotionModifier) : nullptr;
+		if (!WarpModifier) continue;
+
+		FClimbWarpWindow& Window = WarpWindows.AddDefaulted_GetRef();
+		Window.WarpTargetName = WarpModifier->WarpTargetName;
+		Window.StartTime = NotifyEvent.GetTriggerTime();
+		Window.EndTime = NotifyEvent.GetEndTriggerTime();
+	}
+
+	//Every window ending before another is fully applied by then, which BuildWarpCorrections relies on
+	WarpWindows.Sort([](const FClimbWarpWindow& A, const FClimbWarpWindow& B) { return A.EndTime < B.EndTime; });
+}
+
+FVector FClimbRootMotionTrack::EvaluateTranslation(float Time) const
+{
+	if (!IsValid()) return FVector::ZeroVector;
+
+	const float SamplePosition = FMath::Clamp(Time * SampleRate, 0.f, (float)(Translations.Num() - 1));
+	const int32 SampleIndex = FMath::Min(FMath::FloorToInt32(SamplePosition), Translations.Num() - 2);
+
+	return FVector(FMath::Lerp(Translations[SampleIndex], Translations[SampleIndex + 1], SamplePosition - SampleIndex));
+}
+
+float FClimbRootMotionTrack::EvaluateDistance(float Time) const
+{
+	if (!IsValid()) return 0.f;
+
+	const float SamplePosition = FMath::Clamp(Time * SampleRate, 0.f, (float)(Distances.Num() - 1));
+	const int32 SampleIndex = FMath::Min(FMath::FloorToInt32(SamplePosition), Distances.Num() - 2);
+
+	return FMath::Lerp(Distances[SampleIndex], Distances[SampleIndex + 1], SamplePosition - SampleIndex);
+}
+
+float FClimbRootMotionTrack::GetWarpAlpha(const FClimbWarpWindow& Window, float Time) const
+{
+	if (Time <= Window.StartTime) return 0.f;
+	if (Time >= Window.EndTime) return 1.f;
+
+	const float StartDistance = EvaluateDistance(Window.StartTime);
+	const float WindowDistance = EvaluateDistance(Window.EndTime) - StartDistance;
+
+	//No root movement inside the window, spread the correction over time instead
+	if (WindowDistance <= UE_KINDA_SMALL_NUMBER)
+	{
+		return (Time - Window.StartTime) / (Window.EndTime - Window.StartTime);
+	}
+
+	return (EvaluateDistance(Time) - StartDistance) / WindowDistance;
+}
+#pragma endregion
+
+#pragma region RootMotionSource
+FRootMotionSource_ClimbAction::FRootMotionSource_ClimbAction()
+{
+	AccumulateMode = ERootMotionAccumulateMode::Override;
+
+	//Montages hand back to climbing or walking from rest
+	FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::SetVelocity;
+	FinishVelocityParams.SetVelocity = FVector::ZeroVector;
+}
+
+void FRootMotionSource_ClimbAction::BuildWarpCorrections(const FClimbRootMotionTrack& Track, TConstArrayView<FName> WarpTargetNames, TConstArrayView<FVector> WarpTargetLocations, float CapsuleHalfHeight)
+{
+	WarpCorrections.Reset(Track.WarpWindows.Num());
+
+	FVector AppliedCorrection = FVector::ZeroVector;
+
+	for (const FClimbWarpWindow& Window : Track.WarpWindows)
+	{
+		const int32 TargetIndex = WarpTargetNames.Find(Window.WarpTargetName);
+		if (!WarpTargetLocations.IsValidIndex(TargetIndex))
+		{
+			WarpCorrections.Add(FVector::ZeroVector);
+			continue;
+		}
+
+		//Warp targets are root locations, the root sits at the bottom of the capsule
+		const FVector TargetLocation = WarpTargetLocations[TargetIndex] + FVector::UpVector * CapsuleHalfHeight;
+		const FVector UnwarpedLocation = StartLocation + MeshRotation.RotateVector(Track.EvaluateTranslation(Window.EndTime)) + AppliedCorrection;
+
+		const FVector Correction = TargetLocation - UnwarpedLocation;
+		WarpCorrections.Add(Correction);
+		AppliedCorrection += Correction;
+	}
+}
+
+FVector FRootMotionSource_ClimbAction::EvaluateLocation(const FClimbRootMotionTrack& Track, float Time) const
+{
+	FVector Location = StartLocation + MeshRotation.RotateVector(Track.EvaluateTranslation(Time));
+
+	const int32 NumWindows = FMath::Min(WarpCorrections.Num(), Track.WarpWindows.Num());
+	for (int32 WindowIndex = 0; WindowIndex < NumWindows; WindowIndex++)
+	{
+		Location += WarpCorrections[WindowIndex] * Track.GetWarpAlpha(Track.WarpWindows[WindowIndex], Time);
+	}
+
+	return Location;
+}
+
+FRootMotionSource* FRootMotionSource_ClimbAction::Clone() const
+{
+	return new FRootMotionSource_ClimbAction(*this);
+}
+
+bool FRootMotionSource_ClimbAction::Matches(const FRootMotionSource* Other) const
+{
+	if (!FRootMotionSource::Matches(Other)) return false;
+
+	//Matches already checked the struct type
+	const FRootMotionSource_ClimbAction* OtherClimbAction = static_cast<const FRootMotionSource_ClimbAction*>(Other);
+
+	return ActionIndex == OtherClimbAction->ActionIndex && StartLocation.Equals(OtherClimbAction->StartLocation, 1.f);
+}
+
+void FRootMotionSource_ClimbAction::PrepareRootMotion(float SimulationTime, float MovementTickTime, const ACharacter& Character, const UCharacterMovementComponent& MoveComponent)
+{
+	RootMotionParams.Clear();
+
+	const UCustomMovementComponent* ClimbMovement = Cast<UCustomMovementComponent>(&MoveComponent);
+	const FClimbRootMotionTrack* Track = ClimbMovement ? ClimbMovement->GetClimbRootMotionTrack(ActionIndex) : nullptr;
+
+	//Machines without the baked track get their location from the server, an empty override would hold them still for the whole action.
+	//Finishing keeps whatever velocity replicated movement gave them
+	if (!Track)
+	{
+		FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity;
+		Status.SetFlag(ERootMotionSourceStatusFlags::Finished);
+		return;
+	}
+
+	if (Duration > UE_SMALL_NUMBER && MovementTickTime > UE_SMALL_NUMBER)
+	{
+		const float EndTime = FMath::Min(GetTime() + SimulationTime, Duration);
+		const FVector TargetLocation = EvaluateLocation(*Track, EndTime);
+
+		const FVector Force = (TargetLocation - Character.GetActorLocation()) / MovementTickTime;
+		RootMotionParams.Set(FTransform(Force));
+	}
+
+	SetTime(GetTime() + SimulationTime);
+}
+
+bool FRootMotionSource_ClimbAction::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	if (!FRootMotionSource::NetSerialize(Ar, Map, bOutSuccess)) return false;
+
+	Ar << ActionIndex;
+
+	//Same quantization as replicated movement, tenth of a centimetre for the start and whole centimetres for the corrections
+	bOutSuccess = SerializePackedVector<10, 24>(StartLocation, Ar);
+
+	//16 bits an axis, well below a visible error on the mesh
+	FRotator MeshRotator = MeshRotation.Rotator();
+	MeshRotator.SerializeCompressedShort(Ar);
+
+	uint32 NumWarpCorrections = FMath::Min(WarpCorrections.Num(), MaxClimbTransitionWarpTargets);
+	Ar.SerializeInt(NumWarpCorrections, MaxClimbTransitionWarpTargets + 1);
+
+	if (Ar.IsLoading())
+	{
+		MeshRotation = MeshRotator.Quaternion();
+		WarpCorrections.SetNum(NumWarpCorrections);
+	}
+
+	for (uint32 WarpIndex = 0; WarpIndex < NumWarpCorrections; WarpIndex++)
+	{
+		bOutSuccess &= SerializePackedVector<1, 20>(WarpCorrections[WarpIndex], Ar);
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return true;
+}
+
+UScriptStruct* FRootMotionSource_ClimbAction::GetScriptStruct() const
+{
+	return FRootMotionSource_ClimbAction::StaticStruct();
+}
+
+FString FRootMotionSource_ClimbAction::ToSimpleString() const
+{
+	return FString::Printf(TEXT("[ID:%u]FRootMotionSource_ClimbAction %s action %u"), LocalID, *InstanceName.GetPlainNameString(), ActionIndex);
+}
+#pragma endregion
@@ -0,0 +1,266 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbSurfaceHits.h"
+#include "Components/PrimitiveComponent.h"
+#include "Math/VectorRegister.h"
+
+namespace ClimbSurfaceHitsKernel
+{
+	static FORCEINLINE float HorizontalSum(const VectorRegister4Float& Value)
+	{
+		MS_ALIGN(16) float Lanes[4] GCC_ALIGN(16);
+		VectorStoreAligned(Value, Lanes);
+		return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+	}
+}
+
+void FClimbSurfaceHits::Reserve(int32 InNumHits)
+{
+	const int32 PaddedNum = Align(InNumHits, LaneWidth);
+
+	PositionX.Reserve(PaddedNum);
+	PositionY.Reserve(PaddedNum);
+	PositionZ.Reserve(PaddedNum);
+	NormalX.Reserve(PaddedNum);
+	NormalY.Reserve(PaddedNum);
+	NormalZ.Reserve(PaddedNum);
+	PrimitiveIndices.Reserve(PaddedNum);
+}
+
+void FClimbSurfaceHits::Reset(const FVector& InOrigin)
+{
+	Origin = InOrigin;
+	NumHits = 0;
+
+	PositionX.Reset();
+	PositionY.Reset();
+	PositionZ.Reset();
+	NormalX.Reset();
+	NormalY.Reset();
+	NormalZ.Reset();
+	PrimitiveIndices.Reset();
+	Primitives.Reset();
+}
+
+void FClimbSurfaceHits::Add(const FHitResult& Hit)
+{
+	//Open a new zeroed group of four lanes, padding lanes add nothing to the sums
+	if (NumHits % LaneWidth == 0)
+	{
+		PositionX.AddZeroed(LaneWidth);
+		PositionY.AddZeroed(LaneWidth);
+		PositionZ.AddZeroed(LaneWidth);
+		NormalX.AddZeroed(LaneWidth);
+		NormalY.AddZeroed(LaneWidth);
+		NormalZ.AddZeroed(LaneWidth);
+		PrimitiveIndices.AddZeroed(LaneWidth);
+	}
+
+	const FVector RelativePosition = Hit.ImpactPoint - Origin;
+
+	PositionX[NumHits] = (float)RelativePosition.X;
+	PositionY[NumHits] = (float)RelativePosition.Y;
+	PositionZ[NumHits] = (float)RelativePosition.Z;
+	NormalX[NumHits] = (float)Hit.ImpactNormal.X;
+	NormalY[NumHits] = (float)Hit.ImpactNormal.Y;
+	NormalZ[NumHits] = (float)Hit.ImpactNormal.Z;
+
+	PrimitiveIndices[NumHits] = Primitives.AddUnique(Hit.Component);
+
+	NumHits++;
+}
+
+UPrimitiveComponent* FClimbSurfaceHits::GetPrimitive(int32 HitIndex) const
+{
+	return Primitives.IsValidIndex(PrimitiveIndices[HitIndex]) ? Primitives[PrimitiveIndices[HitIndex]].Get() : nullptr;
+}
+
+void FClimbSurfaceHits::ReduceCentroidAndNormal(FVector& OutCentroid, FVector& OutNormal) const
+{
+	OutCentroid = FVector::ZeroVector;
+	OutNormal = FVector::ZeroVector;
+
+	if (NumHits == 0) return;
+
+	VectorRegister4Float SumPositionX = VectorZeroFloat();
+	VectorRegister4Float SumPositionY = VectorZeroFloat();
+	VectorRegister4Float SumPositionZ = VectorZeroFloat();
+	VectorRegister4Float SumNormalX = VectorZeroFloat();
+	VectorRegister4Float SumNormalY = VectorZeroFloat();
+	VectorRegister4Float SumNormalZ = VectorZeroFloat();
+
+	const int32 PaddedNum = PositionX.Num();
+	for (int32 LaneIndex = 0; LaneIndex < PaddedNum; LaneIndex += LaneWidth)
+	{
+		SumPositionX = VectorAdd(SumPositionX, VectorLoadAligned(&PositionX[LaneIndex]));
+		SumPositionY = VectorAdd(SumPositionY, VectorLoadAligned(&PositionY[LaneIndex]));
+		SumPositionZ = VectorAdd(SumPositionZ, VectorLoadAligned(&PositionZ[LaneIndex]));
+		SumNormalX = VectorAdd(SumNormalX, VectorLoadAligned(&NormalX[LaneIndex]));
+		SumNormalY = VectorAdd(SumNormalY, VectorLoadAligned(&NormalY[LaneIndex]));
+		SumNormalZ = VectorAdd(SumNormalZ, VectorLoadAligned(&NormalZ[LaneIndex]));
+	}
+
+	using namespace ClimbSurfaceHitsKernel;
+
+	const FVector PositionSum(HorizontalSum(SumPositionX), HorizontalSum(SumPositionY), HorizontalSum(SumPositionZ));
+	const FVector NormalSum(HorizontalSum(SumNormalX), HorizontalSum(SumNormalY), HorizontalSum(SumNormalZ));
+
+	OutCentroid = Origin + PositionSum / NumHits;
+	OutNormal = NormalSum.GetSafeNormal();
+}
+
+bool FClimbSurfaceHits::FitPlane(const FClimbSurfaceFitSettings& Settings, FClimbSurfaceFit& OutFit) const
+{
+	OutFit = FClimbSurfaceFit();
+
+	FVector InitialCentroid;
+	FVector InitialNormal;
+	ReduceCentroidAndNormal(InitialCentroid, InitialNormal);
+
+	if (InitialNormal.IsNearlyZero()) return false;
+
+	using namespace ClimbSurfaceHitsKernel;
+
+	//Everything below runs relative to Origin in floats, like the stored lanes
+	FVector3f PlaneCentroid = FVector3f(InitialCentroid - Origin);
+	FVector3f PlaneNormal = FVector3f(InitialNormal);
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float MinNormalDot = VectorSetFloat1(Settings.MinNormalDot);
+	const VectorRegister4Float InvResidualScaleSquared = VectorSetFloat1(1.f / FMath::Square(FMath::Max(Settings.ResidualScale, UE_KINDA_SMALL_NUMBER)));
+
+	const int32 PaddedNum = PositionX.Num();
+
+	//Lane numbers of the first group, compared against the hit count to mask the padding lanes out
+	const VectorRegister4Float LaneOffsets = MakeVectorRegisterFloat(0.f, 1.f, 2.f, 3.f);
+	const VectorRegister4Float HitCount = VectorSetFloat1((float)NumHits);
+
+	float Coherence = 0.f;
+	float NumInliers = 0.f;
+
+	for (int32 Iteration = 0; Iteration < FMath::Max(Settings.NumIterations, 1); Iteration++)
+	{
+		const VectorRegister4Float PlaneNormalX = VectorSetFloat1(PlaneNormal.X);
+		const VectorRegister4Float PlaneNormalY = VectorSetFloat1(PlaneNormal.Y);
+		const VectorRegister4Float PlaneNormalZ = VectorSetFloat1(PlaneNormal.Z);
+		const VectorRegister4Float PlaneCentroidX = VectorSetFloat1(PlaneCentroid.X);
+		const VectorRegister4Float PlaneCentroidY = VectorSetFloat1(PlaneCentroid.Y);
+		const VectorRegister4Float PlaneCentroidZ = VectorSetFloat1(PlaneCentroid.Z);
+
+		FVector3f Tangent;
+		FVector3f Bitangent;
+		PlaneNormal.FindBestAxisVectors(Tangent, Bitangent);
+
+		const VectorRegister4Float TangentX = VectorSetFloat1(Tangent.X);
+		const VectorRegister4Float TangentY = VectorSetFloat1(Tangent.Y);
+		const VectorRegister4Float TangentZ = VectorSetFloat1(Tangent.Z);
+		const VectorRegister4Float BitangentX = VectorSetFloat1(Bitangent.X);
+		const VectorRegister4Float BitangentY = VectorSetFloat1(Bitangent.Y);
+		const VectorRegister4Float BitangentZ = VectorSetFloat1(Bitangent.Z);
+
+		VectorRegister4Float SumWeight = Zero;
+		VectorRegister4Float SumInliers = Zero;
+		VectorRegister4Float SumNormalX = Zero, SumNormalY = Zero, SumNormalZ = Zero;
+		VectorRegister4Float SumU = Zero, SumV = Zero, SumH = Zero;
+		VectorRegister4Float SumUU = Zero, SumUV = Zero, SumVV = Zero, SumUH = Zero, SumVH = Zero;
+
+		for (int32 LaneIndex = 0; LaneIndex < PaddedNum; LaneIndex += LaneWidth)
+		{
+			const VectorRegister4Float HitNormalX = VectorLoadAligned(&NormalX[LaneIndex]);
+			const VectorRegister4Float HitNormalY = VectorLoadAligned(&NormalY[LaneIndex]);
+			const VectorRegister4Float HitNormalZ = VectorLoadAligned(&NormalZ[LaneIndex]);
+
+			const VectorRegister4Float OffsetX = VectorSubtract(VectorLoadAligned(&PositionX[LaneIndex]), PlaneCentroidX);
+			const VectorRegister4Float OffsetY = VectorSubtract(VectorLoadAligned(&PositionY[LaneIndex]), PlaneCentroidY);
+			const VectorRegister4Float OffsetZ = VectorSubtract(VectorLoadAligned(&PositionZ[LaneIndex]), PlaneCentroidZ);
+
+			const VectorRegister4Float NormalDot = VectorMultiplyAdd(HitNormalZ, PlaneNormalZ, VectorMultiplyAdd(HitNormalY, PlaneNormalY, VectorMultiply(HitNormalX, PlaneNormalX)));
+
+			//Height above the plane and position along it
+			const VectorRegister4Float H = VectorMultiplyAdd(OffsetZ, PlaneNormalZ, VectorMultiplyAdd(OffsetY, PlaneNormalY, VectorMultiply(OffsetX, PlaneNormalX)));
+			const VectorRegister4Float U = VectorMultiplyAdd(OffsetZ, TangentZ, VectorMultiplyAdd(OffsetY, TangentY, VectorMultiply(OffsetX, TangentX)));
+			const VectorRegister4Float V = VectorMultiplyAdd(OffsetZ, BitangentZ, VectorMultiplyAdd(OffsetY, BitangentY, VectorMultiply(OffsetX, BitangentX)));
+
+			//Cauchy weight on the residual, zero for normals that disagree and for padding lanes whatever the outlier angle
+			const VectorRegister4Float ValidMask = VectorCompareLT(VectorAdd(VectorSetFloat1((float)LaneIndex), LaneOffsets), HitCount);
+			const VectorRegister4Float InlierMask = VectorBitwiseAnd(ValidMask, VectorCompareGE(NormalDot, MinNormalDot));
+			const VectorRegister4Float ResidualWeight = VectorDivide(One, VectorMultiplyAdd(VectorMultiply(H, H), InvResidualScaleSquared, One));
+			const VectorRegister4Float Weight = VectorSelect(InlierMask, ResidualWeight, Zero);
+
+			SumWeight = VectorAdd(SumWeight, Weight);
+			SumInliers = VectorAdd(SumInliers, VectorSelect(InlierMask, One, Zero));
+
+			SumNormalX = VectorMultiplyAdd(Weight, HitNormalX, SumNormalX);
+			SumNormalY = VectorMultiplyAdd(Weight, HitNormalY, SumNormalY);
+			SumNormalZ = VectorMultiplyAdd(Weight, HitNormalZ, SumNormalZ);
+
+			const VectorRegister4Float WeightU = VectorMultiply(Weight, U);
+			const VectorRegister4Float WeightV = VectorMultiply(Weight, V);
+
+			SumU = VectorAdd(SumU, WeightU);
+			SumV = VectorAdd(SumV, WeightV);
+			SumH = VectorMultiplyAdd(Weight, H, SumH);
+			SumUU = VectorMultiplyAdd(WeightU, U, SumUU);
+			SumUV = VectorMultiplyAdd(WeightU, V, SumUV);
+			SumVV = VectorMultiplyAdd(WeightV, V, SumVV);
+			SumUH = VectorMultiplyAdd(WeightU, H, SumUH);
+			SumVH = VectorMultiplyAdd(WeightV, H, SumVH);
+		}
+
+		const float TotalWeight = HorizontalSum(SumWeight);
+		if (TotalWeight <= UE_KINDA_SMALL_NUMBER) break;
+
+		NumInliers = HorizontalSum(SumInliers);
+
+		const FVector3f WeightedNormal = FVector3f(HorizontalSum(SumNormalX), HorizontalSum(SumNormalY), HorizontalSum(SumNormalZ)) / TotalWeight;
+		Coherence = WeightedNormal.Size();
+
+		//Weighted centroid in the plane frame
+		const float MeanU = HorizontalSum(SumU) / TotalWeight;
+		const float MeanV = HorizontalSum(SumV) / TotalWeight;
+		const float MeanH = HorizontalSum(SumH) / TotalWeight;
+
+		PlaneCentroid += Tangent * MeanU + Bitangent * MeanV + PlaneNormal * MeanH;
+
+		FVector3f FittedNormal = WeightedNormal.GetSafeNormal();
+
+		//Least squares h = a*u + b*v over the centred hits, only when they spread out enough to pin down a slope
+		const float CovUU = HorizontalSum(SumUU) / TotalWeight - MeanU * MeanU;
+		const float CovUV = HorizontalSum(SumUV) / TotalWeight - MeanU * MeanV;
+		const float CovVV = HorizontalSum(SumVV) / TotalWeight - MeanV * MeanV;
+		const float CovUH = HorizontalSum(SumUH) / TotalWeight - MeanU * MeanH;
+		const float CovVH = HorizontalSum(SumVH) / TotalWeight - MeanV * MeanH;
+
+		const float Determinant = CovUU * CovVV - CovUV * CovUV;
+		const float MinSpreadSquared = FMath::Square(Settings.MinPointSpread);
+
+		if (NumInliers >= 3.f && CovUU >= MinSpreadSquared && CovVV >= MinSpreadSquared && Determinant > MinSpreadSquared * MinSpreadSquared * 0.25f)
+		{
+			const float SlopeU = (CovUH * CovVV - CovVH * CovUV) / Determinant;
+			const float SlopeV = (CovVH * CovUU - CovUH * CovUV) / Determinant;
+
+			const FVector3f PointNormal = (PlaneNormal - Tangent * SlopeU - Bitangent * SlopeV).GetSafeNormal();
+
+			//Positions refine the normal, they do not get to flip it away from what the hits report
+			if (FVector3f::DotProduct(PointNormal, FittedNormal) >= Settings.MinNormalDot)
+			{
+				FittedNormal = PointNormal;
+			}
+		}
+
+		if (FittedNormal.IsNearlyZero()) break;
+
+		PlaneNormal = FittedNormal;
+	}
+
+	if (NumInliers < 1.f) return false;
+
+	OutFit.Location = Origin + FVector(PlaneCentroid);
+	OutFit.Normal = FVector(PlaneNormal);
+	OutFit.NumInliers = FMath::RoundToInt(NumInliers);
+	OutFit.Confidence = FMath::Clamp(Coherence * NumInliers / NumHits, 0.f, 1.f);
+
+	return true;
+}
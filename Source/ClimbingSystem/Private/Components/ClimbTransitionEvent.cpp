@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbTransitionEvent.h"
+#include "Engine/NetSerialization.h"
+
+bool FClimbTransitionEvent::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	Ar << ActionId;
+	Ar << Sequence;
+	Ar << ServerTimestamp;
+
+	bOutSuccess &= SerializePackedVector<1, 24>(StartLocation, Ar);
+
+	uint32 NumWarpTargets = FMath::Min(WarpTargetOffsets.Num(), MaxClimbTransitionWarpTargets);
+	Ar.SerializeInt(NumWarpTargets, MaxClimbTransitionWarpTargets + 1);
+
+	if (Ar.IsLoading())
+	{
+		WarpTargetOffsets.SetNum(NumWarpTargets);
+	}
+
+	//Whole centimetres, a bit count header and at most 13 bits a component, clamped at about +-40.96m. Hop and vault targets stay within a few metres
+	for (uint32 WarpIndex = 0; WarpIndex < NumWarpTargets; WarpIndex++)
+	{
+		bOutSuccess &= SerializePackedVector<1, 12>(WarpTargetOffsets[WarpIndex], Ar);
+	}
+
+	return !Ar.IsError();
+}
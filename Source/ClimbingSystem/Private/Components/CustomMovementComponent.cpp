@@ -2,13 +2,59 @@
 
 
 #include "Components/CustomMovementComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "ClimbingSystem/ClimbingSystemCharacter.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "MotionWarpingComponent.h"
+#include "DrawDebugHelpers.h"
+#include "UObject/UObjectIterator.h"
+#include "Data/ClimbSurfaceGraph.h"
+#include "Subsystems/ClimbSurfaceGraphSubsystem.h"
+#include "Subsystems/ClimbBatchSubsystem.h"
+#include "Subsystems/ClimbQueryScheduler.h"
+#include "Replication/ClimbReplicationGraph.h"
+#include "Core/ClimbDecisionCore.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Animation/AnimMontage.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
 
 #include "ClimbingSystem/DebugHelper.h"
+#include "ClimbingSystem/ClimbingStats.h"
+
+//Test prediction with a listen server and e.g. "Net PktLag=150" / "Net PktLoss=5", then run this on the server
+static FAutoConsoleCommandWithWorld ReportClimbCorrectionsCommand(
+	TEXT("Climb.Net.ReportCorrections"),
+	TEXT("Logs how many movement corrections the server sent to each climbing character"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+		{
+			if (It->GetWorld() != World || !It->GetCharacterOwner()) continue;
+
+			Debug::Print(FString::Printf(TEXT("%s: %d corrections, %d from climb surface mismatch"),
+				*It->GetCharacterOwner()->GetName(), It->GetNumServerCorrections(), It->GetNumClimbSurfaceCorrections()), FColor::Cyan);
+		}
+	})
+);
+
+static ClimbDecision::FVec3 ToClimbDecisionVector(const FVector& InVector)
+{
+	return ClimbDecision::FVec3{ (float)InVector.X, (float)InVector.Y, (float)InVector.Z };
+}
+
+static FVector FromClimbDecisionVector(const ClimbDecision::FVec3& InVector)
+{
+	return FVector(InVector.X, InVector.Y, InVector.Z);
+}
+
+UCustomMovementComponent::UCustomMovementComponent()
+{
+	SetNetworkMoveDataContainer(ClimbNetworkMoveDataContainer);
+}
 
 #pragma region OverridenFunctions
 void UCustomMovementComponent::BeginPlay()
@@ -24,17 +70,79 @@ void UCustomMovementComponent::BeginPlay()
 	}
 
 	OwningPlayerCharacter = Cast<AClimbingSystemCharacter>(CharacterOwner);
+
+	InitClimbQueryParams();
+
+	InitClimbActions();
+
+	DefaultNetUpdateFrequency = CharacterOwner->NetUpdateFrequency;
+
+	//Nothing on a dedicated server looks at the pose once climb actions no longer need montages
+	if (ShouldUseServerClimbActions())
+	{
+		CharacterOwner->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	}
+
+	ClimbEntryProbeDelegate.BindUObject(this, &UCustomMovementComponent::OnClimbEntryProbeCompleted);
+	HopAvailabilityProbeDelegate.BindUObject(this, &UCustomMovementComponent::OnHopAvailabilityProbeCompleted);
+}
+
+void UCustomMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	//The owning client predicted the transition itself
+	DOREPLIFETIME_CONDITION(UCustomMovementComponent, ReplicatedClimbTransition, COND_SimulatedOnly);
+	DOREPLIFETIME_CONDITION(UCustomMovementComponent, ReplicatedClimbSurface, COND_SimulatedOnly);
 }
 
 void UCustomMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	const uint64 TickStartCycles = FPlatformTime::Cycles64();
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateClimbStepInterpolation();
+
+	UpdateClimbAnimSnapshot();
+
+	UpdateClimbActionStreaming(DeltaTime);
+
+	UpdateServerClimbAction();
+
+	UpdateReplicatedClimbSurface();
+
+	UpdateHopAvailability(DeltaTime);
+
+	if (bUseClimbLOD)
+	{
+		ClimbLODUpdateTimer -= DeltaTime;
+		if (ClimbLODUpdateTimer <= 0.f)
+		{
+			ClimbLODUpdateTimer = ClimbLODUpdateInterval;
+			UpdateClimbLOD();
+		}
+	}
+
+	LastMovementTickCycles = FPlatformTime::Cycles64() - TickStartCycles;
 }
 
 void UCustomMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
 {
+	//Montage callbacks change modes outside PerformMovement, batch the capsule resize and rotation reset into one update
+	FScopedMovementUpdate ScopedCapsuleUpdate(UpdatedComponent, EScopedUpdate::DeferredUpdates);
+
+	ClimbSurfaceCache.bValid = false;
+	AnalyticClimbSurface.Reset();
+	bHasFilteredClimbSurface = false;
+	bHasClimbStepInterpolation = false;
+	ClimbStepAccumulator = 0.f;
+
 	if (IsClimbing())
 	{
+		SetClimbState(EClimbState::Hanging);
+		RequestFullClimbFidelity(ClimbLODTransitionHoldTime);
+
 		bOrientRotationToMovement = false;
 		CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(48.f);
 
@@ -52,8 +160,18 @@ void UCustomMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovem
 
 		StopMovementImmediately();
 
+		//Letting go is only over once the character lands
+		SetClimbState(MovementMode == MOVE_Falling ? EClimbState::Exiting : EClimbState::None);
+		ActiveClimbProbes = ClimbProbes::None;
+
 		OnExitClimbStateDelegate.ExecuteIfBound();
 	}
+	else if (ClimbState == EClimbState::Exiting && MovementMode != MOVE_Falling)
+	{
+		SetClimbState(EClimbState::None);
+	}
+
+	UpdateClimbBatchRegistration();
 
 	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
 }
@@ -68,6 +186,84 @@ void UCustomMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
 	Super::PhysCustom(deltaTime, Iterations);
 }
 
+FNetworkPredictionData_Client* UCustomMovementComponent::GetPredictionData_Client() const
+{
+	if (!ClientPredictionData)
+	{
+		UCustomMovementComponent* MutableThis = const_cast<UCustomMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Climb(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+void UCustomMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	bWantsToStartClimbing = (Flags & ClimbMoveFlags::StartClimb) != 0;
+	bWantsToStopClimbing = (Flags & ClimbMoveFlags::StopClimb) != 0;
+	bWantsToHop = (Flags & ClimbMoveFlags::Hop) != 0;
+}
+
+void UCustomMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	const bool bStartClimbing = bWantsToStartClimbing;
+	const bool bStopClimbing = bWantsToStopClimbing;
+	const bool bHop = bWantsToHop;
+
+	bWantsToStartClimbing = false;
+	bWantsToStopClimbing = false;
+	bWantsToHop = false;
+
+	//Montages and warp targets are not part of a replayed move
+	if (CharacterOwner->bClientUpdating) return;
+
+	//AI transitions wait in the scheduler for budget, player input always runs now
+	UClimbQueryScheduler* QueryScheduler = CharacterOwner->IsPlayerControlled() ? nullptr : GetClimbQueryScheduler();
+
+	if (bStartClimbing)
+	{
+		if (QueryScheduler) QueryScheduler->EnqueueQuery(this, EClimbQueryKind::StartClimbing, EClimbQueryPriority::AITransition);
+		else ExecuteToggleClimbing(true);
+	}
+
+	if (bStopClimbing) ExecuteToggleClimbing(false);
+
+	if (bHop)
+	{
+		if (QueryScheduler) QueryScheduler->EnqueueQuery(this, EClimbQueryKind::Hop, EClimbQueryPriority::AITransition);
+		else ExecuteHopping();
+	}
+}
+
+bool UCustomMovementComponent::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientLoc, const FVector& RelativeClientLoc, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	bool bNeedsCorrection = Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientLoc, RelativeClientLoc, ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+
+	const FClimbNetworkMoveData* ClimbMoveData = static_cast<const FClimbNetworkMoveData*>(GetCurrentNetworkMoveData());
+
+	if (!bNeedsCorrection && ClimbMoveData && ClimbMoveData->bIsClimbing && IsClimbing())
+	{
+		const float NormalDot = FVector::DotProduct(ClimbMoveData->ClimbSurfaceNormal, CurrentClimbableSurfaceNormal);
+
+		if (NormalDot < FMath::Cos(FMath::DegreesToRadians(ClimbSurfaceNormalErrorTolerance)))
+		{
+			bNeedsCorrection = true;
+			NumClimbSurfaceCorrections++;
+		}
+	}
+
+	if (bNeedsCorrection)
+	{
+		NumServerCorrections++;
+	}
+
+	return bNeedsCorrection;
+}
+
 float UCustomMovementComponent::GetMaxSpeed() const
 {
 	if (IsClimbing())
@@ -110,252 +306,1461 @@ FVector UCustomMovementComponent::ConstrainAnimRootMotionVelocity(const FVector&
 
 #pragma region ClimbTraces
 
-TArray<FHitResult> UCustomMovementComponent::DoCapsuleTraceMultiByObject(const FVector& Start, const FVector& End, bool bShowDebugShape, bool bDrawPersistantShape)
+void UCustomMovementComponent::InitClimbQueryParams()
+{
+	ClimbObjectQueryParams = FCollisionObjectQueryParams(ClimbableSurfaceTraceTypes);
+
+	ClimbQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ClimbTrace), false);
+
+	ClimbableSurfaceHits.Reserve(ClimbHitBufferReserve);
+	FloorHits.Reserve(ClimbHitBufferReserve);
+}
+
+void UCustomMovementComponent::RefreshClimbQueryFrame()
 {
-	TArray<FHitResult> OutCapsuleTraceHitResults;
+	const FTransform& ComponentTransform = UpdatedComponent->GetComponentTransform();
+
+	ClimbQueryFrame.Location = ComponentTransform.GetLocation();
+	ClimbQueryFrame.Quat = ComponentTransform.GetRotation();
+	ClimbQueryFrame.Forward = ClimbQueryFrame.Quat.GetForwardVector();
+	ClimbQueryFrame.Right = ClimbQueryFrame.Quat.GetRightVector();
+	ClimbQueryFrame.Up = ClimbQueryFrame.Quat.GetUpVector();
+}
+
+bool UCustomMovementComponent::DoCapsuleTraceMultiByObject(const FVector& Start, const FVector& End, FClimbSurfaceHits& OutHits, bool bShowDebugShape, bool bDrawPersistantShape)
+{
+	//The scene query API only hands back full hit results, one game thread scratch buffer is shared by every climber
+	static TArray<FHitResult> SweepScratch;
+	check(IsInGameThread());
+
+	const uint64 QueryStartCycles = FPlatformTime::Cycles64();
+
+	SweepScratch.Reset();
+	NumClimbQueriesIssued++;
+
+	GetWorld()->SweepMultiByObjectType(
+		SweepScratch,
+		Start,
+		End,
+		FQuat::Identity,
+		ClimbObjectQueryParams,
+		FCollisionShape::MakeCapsule(ClimbCapsuleTraceRadius, ClimbCapsuleTraceHalfHeight),
+		ClimbQueryParams
+	);
+
+	ChargeClimbQueryCycles(QueryStartCycles);
+
+	ClimbStats::RecordProbe(EClimbProbeShape::Capsule, Start, End, SweepScratch.Num());
 
-	EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
+	OutHits.Reset(Start);
+	for (const FHitResult& Hit : SweepScratch)
+	{
+		OutHits.Add(Hit);
+	}
+
+#if ENABLE_DRAW_DEBUG
 	if (bShowDebugShape)
 	{
-		DebugTraceType = EDrawDebugTrace::ForOneFrame;
+		const float LifeTime = bDrawPersistantShape ? -1.f : 0.f;
+		const FColor TraceColor = OutHits.IsEmpty() ? FColor::Red : FColor::Green;
+
+		DrawDebugCapsule(GetWorld(), Start, ClimbCapsuleTraceHalfHeight, ClimbCapsuleTraceRadius, FQuat::Identity, TraceColor, bDrawPersistantShape, LifeTime);
+		DrawDebugCapsule(GetWorld(), End, ClimbCapsuleTraceHalfHeight, ClimbCapsuleTraceRadius, FQuat::Identity, TraceColor, bDrawPersistantShape, LifeTime);
 
-		if (bDrawPersistantShape)
+		for (int32 HitIndex = 0; HitIndex < OutHits.Num(); HitIndex++)
 		{
-			DebugTraceType = EDrawDebugTrace::Persistent;
+			DrawDebugPoint(GetWorld(), OutHits.GetPosition(HitIndex), 10.f, FColor::Green, bDrawPersistantShape, LifeTime);
 		}
 	}
+#endif
 
-	UKismetSystemLibrary::CapsuleTraceMultiForObjects(
-		this,
+	return !OutHits.IsEmpty();
+}
+
+FHitResult UCustomMovementComponent::DoLineTraceSingleByObject(const FVector& Start, const FVector& End, bool bShowDebugShape, bool bDrawPersistantShape)
+{
+	const uint64 QueryStartCycles = FPlatformTime::Cycles64();
+
+	FHitResult OutHit;
+	NumClimbQueriesIssued++;
+
+	GetWorld()->LineTraceSingleByObjectType(
+		OutHit,
 		Start,
 		End,
-		ClimbCapsuleTraceRadius,
-		ClimbCapsuleTraceHalfHeight,
-		ClimbableSurfaceTraceTypes,
-		false,
-		TArray<AActor*>(),
-		DebugTraceType,
-		OutCapsuleTraceHitResults,
-		false
+		ClimbObjectQueryParams,
+		ClimbQueryParams
 	);
 
-	return OutCapsuleTraceHitResults;
+	ChargeClimbQueryCycles(QueryStartCycles);
+
+	ClimbStats::RecordProbe(EClimbProbeShape::Line, Start, End, OutHit.bBlockingHit ? 1 : 0);
+
+#if ENABLE_DRAW_DEBUG
+	if (bShowDebugShape)
+	{
+		const float LifeTime = bDrawPersistantShape ? -1.f : 0.f;
+
+		DrawDebugLine(GetWorld(), Start, End, OutHit.bBlockingHit ? FColor::Green : FColor::Red, bDrawPersistantShape, LifeTime);
+
+		if (OutHit.bBlockingHit)
+		{
+			DrawDebugPoint(GetWorld(), OutHit.ImpactPoint, 10.f, FColor::Green, bDrawPersistantShape, LifeTime);
+		}
+	}
+#endif
+
+	return OutHit;
 }
 
-FHitResult UCustomMovementComponent::DoLineTraceSingleByObject(const FVector& Start, const FVector& End, bool bShowDebugShape, bool bDrawPersistantShape)
+FHitResult UCustomMovementComponent::DoClimbProbe(const FVector& Start, const FVector& End, bool bShowDebugShape, bool bDrawPersistantShape)
 {
-	FHitResult OutHit;
+	const UClimbSurfaceGraph* BakedGraph = GetBakedClimbGraph();
 
-	EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
-	if (bShowDebugShape)
+	const FVector ProbeDelta = End - Start;
+	const float ProbeLength = ProbeDelta.Size();
+
+	if (BakedGraph && ProbeLength > UE_KINDA_SMALL_NUMBER && BakedGraph->HasCoverage(Start + ProbeDelta * 0.5f, ProbeLength * 0.5f + BakedClimbGraphTolerance))
 	{
-		DebugTraceType = EDrawDebugTrace::ForOneFrame;
+		FHitResult OutHit(Start, End);
 
-		if (bDrawPersistantShape)
+		int32 NodeIndex;
+		if (BakedGraph->FindNodeAlongRay(Start, ProbeDelta / ProbeLength, ProbeLength, BakedClimbGraphTolerance, EClimbGraphNodeType::GrabPoint, NodeIndex))
 		{
-			DebugTraceType = EDrawDebugTrace::Persistent;
+			const FClimbGraphNode& Node = BakedGraph->GetNode(NodeIndex);
+
+			OutHit.bBlockingHit = true;
+			OutHit.ImpactPoint = Node.Location;
+			OutHit.Location = Node.Location;
+			OutHit.ImpactNormal = FVector(Node.Normal);
+			OutHit.Normal = OutHit.ImpactNormal;
+			OutHit.Distance = FVector::Dist(Start, Node.Location);
+			OutHit.Time = OutHit.Distance / ProbeLength;
 		}
+
+		ClimbStats::RecordProbe(EClimbProbeShape::BakedGraph, Start, End, OutHit.bBlockingHit ? 1 : 0);
+
+		return OutHit;
+	}
+
+	return DoLineTraceSingleByObject(Start, End, bShowDebugShape, bDrawPersistantShape);
+}
+
+const UClimbSurfaceGraph* UCustomMovementComponent::GetBakedClimbGraph() const
+{
+	if (!bUseBakedClimbGraph) return nullptr;
+
+	const UClimbSurfaceGraphSubsystem* GraphSubsystem = GetWorld()->GetSubsystem<UClimbSurfaceGraphSubsystem>();
+	return GraphSubsystem ? GraphSubsystem->GetGraph() : nullptr;
+}
+
+UClimbQueryScheduler* UCustomMovementComponent::GetClimbQueryScheduler() const
+{
+	return bUseClimbQueryScheduler ? GetWorld()->GetSubsystem<UClimbQueryScheduler>() : nullptr;
+}
+
+void UCustomMovementComponent::ChargeClimbQueryCycles(uint64 StartCycles)
+{
+	if (UClimbQueryScheduler* QueryScheduler = GetClimbQueryScheduler())
+	{
+		QueryScheduler->ChargeQueryCycles(FPlatformTime::Cycles64() - StartCycles);
+	}
+}
+
+bool UCustomMovementComponent::AcquireClimbMaintenanceBudget()
+{
+	UClimbQueryScheduler* QueryScheduler = GetClimbQueryScheduler();
+	if (!QueryScheduler) return true;
+
+	EClimbQueryPriority Priority = EClimbQueryPriority::AIMaintenance;
+	if (CharacterOwner->IsPlayerControlled())
+	{
+		Priority = EClimbQueryPriority::PlayerMaintenance;
+	}
+	else if (HasAnimRootMotion())
+	{
+		Priority = EClimbQueryPriority::AITransition;
+	}
+
+	return QueryScheduler->TryAcquireBudget(Priority, ClimbMaintenanceDeferredFrame);
+}
+
+void UCustomMovementComponent::RunScheduledClimbQuery(EClimbQueryKind Kind)
+{
+	switch (Kind)
+	{
+	case EClimbQueryKind::StartClimbing:
+		if (!IsClimbing()) ExecuteToggleClimbing(true);
+		break;
+
+	case EClimbQueryKind::Hop:
+		if (IsClimbing()) ExecuteHopping();
+		break;
+	}
+}
+
+bool UCustomMovementComponent::ValidateClimbTarget(const FVector& InTargetPosition)
+{
+	if (!bValidateBakedClimbTargets || !GetBakedClimbGraph()) return true;
+
+	const FVector Start = InTargetPosition - ClimbQueryFrame.Forward * 30.f;
+	const FVector End = InTargetPosition + ClimbQueryFrame.Forward * 30.f;
+
+	return DoLineTraceSingleByObject(Start, End).bBlockingHit;
+}
+
+#pragma endregion
+
+#pragma region ClimbAsyncProbes
+
+void UCustomMovementComponent::RequestClimbEntryProbes()
+{
+	if (ClimbEntryProbeBatch.bInFlight) return;
+	if (IsFalling()) return;
+
+	//Results that arrive for an older batch are dropped by id
+	ClimbEntryProbeBatch.BatchId = (ClimbEntryProbeBatch.BatchId + 1) & 0x00FFFFFF;
+	ClimbEntryProbeBatch.PendingCount = 0;
+	ClimbEntryProbeBatch.bInFlight = true;
+
+	for (int32 ProbeIndex = 0; ProbeIndex < (int32)EClimbEntryProbe::Num; ProbeIndex++)
+	{
+		ClimbEntryProbeBatch.bBlockingHits[ProbeIndex] = false;
+		ClimbEntryProbeBatch.ImpactPoints[ProbeIndex] = FVector::ZeroVector;
+	}
+
+	const FVector ComponentLocation = ClimbQueryFrame.Location;
+	const FVector ComponentForward = ClimbQueryFrame.Forward;
+	const FVector UpVector = ClimbQueryFrame.Up;
+	const FVector DownVector = -ClimbQueryFrame.Up;
+
+	//Same shape and placement as TraceClimbableSurfaces
+	const FVector SurfaceStart = ComponentLocation + ComponentForward * 30.f;
+	const FVector SurfaceEnd = SurfaceStart + ComponentForward;
+
+	GetWorld()->AsyncSweepByObjectType(
+		EAsyncTraceType::Multi,
+		SurfaceStart,
+		SurfaceEnd,
+		FQuat::Identity,
+		ClimbObjectQueryParams,
+		FCollisionShape::MakeCapsule(ClimbCapsuleTraceRadius, ClimbCapsuleTraceHalfHeight),
+		ClimbQueryParams,
+		&ClimbEntryProbeDelegate,
+		(ClimbEntryProbeBatch.BatchId << 8) | (uint32)EClimbEntryProbe::Surface
+	);
+	ClimbEntryProbeBatch.PendingCount++;
+	NumClimbQueriesIssued++;
+
+	//Same as TraceFromEyeHeight(100.f)
+	const FVector EyeStart = ComponentLocation + UpVector * CharacterOwner->BaseEyeHeight;
+	IssueClimbEntryLineProbe(EClimbEntryProbe::EyeHeight, EyeStart, EyeStart + ComponentForward * 100.f);
+
+	//Same as CanClimbDownLedge
+	const FVector WalkableStart = ComponentLocation + ComponentForward * ClimbDownWalkableSurfaceTraceOffset;
+	IssueClimbEntryLineProbe(EClimbEntryProbe::LedgeWalkable, WalkableStart, WalkableStart + DownVector * 100.f);
+
+	const FVector LedgeStart = WalkableStart + ComponentForward * ClimbDownLedgeTraceOffset;
+	IssueClimbEntryLineProbe(EClimbEntryProbe::LedgeDrop, LedgeStart, LedgeStart + DownVector * 200.f);
+
+	//Same as CanStartVaulting, only the two probes whose results are used
+	for (const int32 VaultStep : { 0, 3 })
+	{
+		const FVector Start = ComponentLocation + UpVector * 100.f + ComponentForward * 80.f * (VaultStep + 1);
+		const FVector End = Start + DownVector * 100.f * (VaultStep + 1);
+
+		IssueClimbEntryLineProbe(VaultStep == 0 ? EClimbEntryProbe::VaultStart : EClimbEntryProbe::VaultLand, Start, End);
 	}
+}
 
-	UKismetSystemLibrary::LineTraceSingleForObjects(
-		this,
+void UCustomMovementComponent::IssueClimbEntryLineProbe(EClimbEntryProbe Probe, const FVector& Start, const FVector& End)
+{
+	GetWorld()->AsyncLineTraceByObjectType(
+		EAsyncTraceType::Single,
 		Start,
 		End,
-		ClimbableSurfaceTraceTypes,
-		false,
-		TArray<AActor*>(),
-		DebugTraceType,
-		OutHit,
-		false
+		ClimbObjectQueryParams,
+		ClimbQueryParams,
+		&ClimbEntryProbeDelegate,
+		(ClimbEntryProbeBatch.BatchId << 8) | (uint32)Probe
 	);
 
-	return OutHit;
+	ClimbEntryProbeBatch.PendingCount++;
+	NumClimbQueriesIssued++;
 }
 
-#pragma endregion
+void UCustomMovementComponent::OnClimbEntryProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (!ClimbEntryProbeBatch.bInFlight) return;
+	if ((TraceDatum.UserData >> 8) != ClimbEntryProbeBatch.BatchId) return;
 
-#pragma region ClimbCore
+	const int32 ProbeIndex = TraceDatum.UserData & 0xFF;
+	if (ProbeIndex >= (int32)EClimbEntryProbe::Num) return;
 
-void UCustomMovementComponent::ToggleClimbing(bool bEnableClimb)
-{
-	if (bEnableClimb)
+	ClimbStats::RecordProbe(
+		(EClimbEntryProbe)ProbeIndex == EClimbEntryProbe::Surface ? EClimbProbeShape::AsyncCapsule : EClimbProbeShape::AsyncLine,
+		TraceDatum.Start, TraceDatum.End, TraceDatum.OutHits.Num());
+
+	for (const FHitResult& Hit : TraceDatum.OutHits)
 	{
-		if (CanStartClimbing())
-		{
-			PlayClimbMontage(IdleToClimbMontage);
-		}
-		else if(CanClimbDownLedge())
+		if (Hit.bBlockingHit || (EClimbEntryProbe)ProbeIndex == EClimbEntryProbe::Surface)
 		{
-			PlayClimbMontage(ClimbingDownLedgeMontage);
-		}
-		else
-		{
-			TryStartVaulting();
+			ClimbEntryProbeBatch.bBlockingHits[ProbeIndex] = true;
+			ClimbEntryProbeBatch.ImpactPoints[ProbeIndex] = Hit.ImpactPoint;
+			break;
 		}
 	}
-	
-	if (!bEnableClimb)
+
+	if (--ClimbEntryProbeBatch.PendingCount == 0)
 	{
-		StopClimbing();
+		ClimbEntryProbeBatch.bInFlight = false;
+		ResolveClimbEntryProbes();
 	}
 }
 
-bool UCustomMovementComponent::CanStartClimbing()
+void UCustomMovementComponent::ResolveClimbEntryProbes()
 {
-	if (IsFalling()) return false;
-	if (!TraceClimbableSurfaces()) return false;
-	if (!TraceFromEyeHeight(100.f).bBlockingHit) return false;
+	//The world may have moved on while the probes were in flight
+	if (IsFalling() || IsClimbing()) return;
 
-	return true;
+	const auto HasHit = [this](EClimbEntryProbe Probe) { return ClimbEntryProbeBatch.bBlockingHits[(int32)Probe]; };
+
+	if (HasHit(EClimbEntryProbe::Surface) && HasHit(EClimbEntryProbe::EyeHeight))
+	{
+		PlayClimbAction(FName("IdleToClimb"));
+	}
+	else if (HasHit(EClimbEntryProbe::LedgeWalkable) && !HasHit(EClimbEntryProbe::LedgeDrop))
+	{
+		PlayClimbAction(FName("ClimbDownLedge"));
+	}
+	else if (HasHit(EClimbEntryProbe::VaultStart) && HasHit(EClimbEntryProbe::VaultLand))
+	{
+		StartClimbing();
+		PlayClimbAction(FName("Vault"), {
+			ClimbEntryProbeBatch.ImpactPoints[(int32)EClimbEntryProbe::VaultStart],
+			ClimbEntryProbeBatch.ImpactPoints[(int32)EClimbEntryProbe::VaultLand]
+		});
+	}
 }
 
-bool UCustomMovementComponent::CanClimbDownLedge()
+void UCustomMovementComponent::UpdateHopAvailability(float DeltaTime)
 {
-	if (IsFalling()) return false;
+	if (!bUseHopAvailabilityMap) return;
 
-	const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-	const FVector ComponentForward = UpdatedComponent->GetForwardVector();
-	const FVector DownVector = -UpdatedComponent->GetUpVector();
+	//Only the locally controlled climber reads the map, the server probes its remote climbers' hops when they happen
+	if (!IsClimbing() || !ClimbStates::IsFreeClimbing(ClimbState) || !CharacterOwner->IsLocallyControlled())
+	{
+		HopAvailability.bValid = false;
+		HopAvailabilityTimer = 0.f;
+		return;
+	}
 
-	const FVector WalkableSurfaceTraceStart = ComponentLocation + ComponentForward * ClimbDownWalkableSurfaceTraceOffset;
-	const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 100.f;
+	HopAvailabilityTimer -= DeltaTime;
+	if (HopAvailabilityTimer > 0.f || HopAvailabilityProbeBatch.bInFlight) return;
 
-	FHitResult WalkableSurfaceHit = DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd);
+	HopAvailabilityTimer = 1.f / FMath::Max(HopAvailabilityRefreshRate, 1.f);
 
-	const FVector LedgeTraceStart = WalkableSurfaceHit.TraceStart + ComponentForward * ClimbDownLedgeTraceOffset;
-	const FVector LedgeTraceEnd = LedgeTraceStart + DownVector * 200.f;
+	RefreshClimbQueryFrame();
+	RequestHopAvailabilityProbes();
+}
+
+void UCustomMovementComponent::RequestHopAvailabilityProbes()
+{
+	HopAvailabilityProbeBatch.BatchId = (HopAvailabilityProbeBatch.BatchId + 1) & 0x00FFFFFF;
+	HopAvailabilityProbeBatch.PendingCount = 0;
+	HopAvailabilityProbeBatch.bInFlight = true;
+	HopAvailabilityProbeBatch.IssueLocation = ClimbQueryFrame.Location;
+
+	for (int32 ProbeIndex = 0; ProbeIndex < (int32)EClimbHopProbe::Num; ProbeIndex++)
+	{
+		HopAvailabilityProbeBatch.bBlockingHits[ProbeIndex] = false;
+		HopAvailabilityProbeBatch.ImpactPoints[ProbeIndex] = FVector::ZeroVector;
+	}
+
+	const FVector ComponentLocation = ClimbQueryFrame.Location;
+	const FVector ComponentForward = ClimbQueryFrame.Forward;
+	const FVector RightVector = ClimbQueryFrame.Right;
+	const FVector EyeHeight = ClimbQueryFrame.Up * CharacterOwner->BaseEyeHeight;
+
+	//Same placement as the CheckCanHop traces
+	const auto IssueForward = [&](EClimbHopProbe Probe, const FVector& Start)
+	{
+		IssueHopAvailabilityProbe(Probe, Start, Start + ComponentForward * 100.f);
+	};
+
+	IssueForward(EClimbHopProbe::Up, ComponentLocation + EyeHeight + ClimbQueryFrame.Up * -10.f);
+	IssueForward(EClimbHopProbe::UpSafety, ComponentLocation + EyeHeight + ClimbQueryFrame.Up * 150.f);
+	IssueForward(EClimbHopProbe::Down, ComponentLocation + EyeHeight + ClimbQueryFrame.Up * -300.f);
+	IssueForward(EClimbHopProbe::Right, ComponentLocation + RightVector * 110.f);
+	IssueForward(EClimbHopProbe::Left, ComponentLocation - RightVector * 110.f);
+}
+
+void UCustomMovementComponent::IssueHopAvailabilityProbe(EClimbHopProbe Probe, const FVector& Start, const FVector& End)
+{
+	GetWorld()->AsyncLineTraceByObjectType(
+		EAsyncTraceType::Single,
+		Start,
+		End,
+		ClimbObjectQueryParams,
+		ClimbQueryParams,
+		&HopAvailabilityProbeDelegate,
+		(HopAvailabilityProbeBatch.BatchId << 8) | (uint32)Probe
+	);
+
+	HopAvailabilityProbeBatch.PendingCount++;
+	NumClimbQueriesIssued++;
+}
+
+void UCustomMovementComponent::OnHopAvailabilityProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (!HopAvailabilityProbeBatch.bInFlight) return;
+	if ((TraceDatum.UserData >> 8) != HopAvailabilityProbeBatch.BatchId) return;
+
+	const int32 ProbeIndex = TraceDatum.UserData & 0xFF;
+	if (ProbeIndex >= (int32)EClimbHopProbe::Num) return;
+
+	ClimbStats::RecordProbe(EClimbProbeShape::AsyncLine, TraceDatum.Start, TraceDatum.End, TraceDatum.OutHits.Num());
+
+	for (const FHitResult& Hit : TraceDatum.OutHits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			HopAvailabilityProbeBatch.bBlockingHits[ProbeIndex] = true;
+			HopAvailabilityProbeBatch.ImpactPoints[ProbeIndex] = Hit.ImpactPoint;
+			break;
+		}
+	}
+
+	if (--HopAvailabilityProbeBatch.PendingCount == 0)
+	{
+		HopAvailabilityProbeBatch.bInFlight = false;
+		ResolveHopAvailabilityProbes();
+	}
+}
+
+void UCustomMovementComponent::ResolveHopAvailabilityProbes()
+{
+	const auto HasHit = [this](EClimbHopProbe Probe) { return HopAvailabilityProbeBatch.bBlockingHits[(int32)Probe]; };
+	const auto GetPoint = [this](EClimbHopProbe Probe) { return HopAvailabilityProbeBatch.ImpactPoints[(int32)Probe]; };
+
+	HopAvailability.AvailableHops = 0;
+
+	const auto SetAvailable = [this](EClimbHopDirection Direction, const FVector& Target)
+	{
+		HopAvailability.AvailableHops |= 1 << (uint8)Direction;
+		HopAvailability.Targets[(int32)Direction] = Target;
+	};
+
+	if (HasHit(EClimbHopProbe::Up) && HasHit(EClimbHopProbe::UpSafety)) SetAvailable(EClimbHopDirection::Up, GetPoint(EClimbHopProbe::Up));
+	if (HasHit(EClimbHopProbe::Down)) SetAvailable(EClimbHopDirection::Down, GetPoint(EClimbHopProbe::Down));
+	if (HasHit(EClimbHopProbe::Right)) SetAvailable(EClimbHopDirection::Right, GetPoint(EClimbHopProbe::Right));
+	if (HasHit(EClimbHopProbe::Left)) SetAvailable(EClimbHopDirection::Left, GetPoint(EClimbHopProbe::Left));
+
+	HopAvailability.SourceLocation = HopAvailabilityProbeBatch.IssueLocation;
+	HopAvailability.Time = GetWorld()->GetTimeSeconds();
+	HopAvailability.bValid = IsClimbing();
+}
+
+bool UCustomMovementComponent::IsHopAvailabilityFresh() const
+{
+	if (!bUseHopAvailabilityMap || !HopAvailability.bValid) return false;
+
+	//Two refresh periods leaves room for one batch still in flight
+	const double MaxAge = 2.0 / FMath::Max(HopAvailabilityRefreshRate, 1.f);
+	if (GetWorld()->GetTimeSeconds() - HopAvailability.Time > MaxAge) return false;
+
+	return FVector::DistSquared(HopAvailability.SourceLocation, UpdatedComponent->GetComponentLocation()) <= FMath::Square(HopAvailabilityMaxDrift);
+}
+
+bool UCustomMovementComponent::ResolveHopTarget(EClimbHopDirection Direction, FVector& OutTargetPosition)
+{
+	//A fresh map is final for the locally controlled climber, a miss included, so the input frame issues no traces.
+	//Remote climbers are probed below on the server, which validates the hop and corrects a client whose map went stale
+	if (CharacterOwner->IsLocallyControlled() && IsHopAvailabilityFresh())
+	{
+		return GetAvailableHopTarget(Direction, OutTargetPosition);
+	}
+
+	//Where the graph is baked its hop edges are authoritative, the same on every machine
+	if (const UClimbSurfaceGraph* BakedGraph = GetBakedClimbGraph())
+	{
+		const float HopSnapRadius = 100.f;
+		const FVector HopFromLocation = CurrentClimbableSurfaceLocation;
+
+		if (BakedGraph->HasCoverage(HopFromLocation, HopSnapRadius))
+		{
+			int32 HopNodeIndex;
+			bool bHasHop = BakedGraph->FindHopTarget(HopFromLocation, HopSnapRadius, Direction, HopNodeIndex);
+
+			if (bHasHop)
+			{
+				OutTargetPosition = BakedGraph->GetNode(HopNodeIndex).Location;
+
+				//Only baked targets can be out of date with the level, traced ones were just confirmed
+				bHasHop = ValidateClimbTarget(OutTargetPosition);
+			}
+
+			ClimbStats::RecordProbe(EClimbProbeShape::BakedGraph, HopFromLocation, bHasHop ? OutTargetPosition : HopFromLocation, bHasHop ? 1 : 0);
+			return bHasHop;
+		}
+	}
+
+	switch (Direction)
+	{
+	case EClimbHopDirection::Up:
+		return CheckCanHopUp(OutTargetPosition);
+	case EClimbHopDirection::Down:
+		return CheckCanHopDown(OutTargetPosition);
+	case EClimbHopDirection::Right:
+		return CheckCanHopRight(OutTargetPosition);
+	case EClimbHopDirection::Left:
+		return CheckCanHopLeft(OutTargetPosition);
+	default:
+		return false;
+	}
+}
+
+bool UCustomMovementComponent::GetAvailableHopTarget(EClimbHopDirection Direction, FVector& OutTargetPosition) const
+{
+	if (!(GetAvailableHops() & (1 << (uint8)Direction))) return false;
+
+	OutTargetPosition = HopAvailability.Targets[(int32)Direction];
+	return true;
+}
+
+#pragma endregion
+
+#pragma region ClimbActions
+
+void UCustomMovementComponent::InitClimbActions()
+{
+	LegacyClimbActions.Reset();
+	RuntimeClimbRootMotionTracks.Reset();
+
+	//Every character shares the set's actions and baked tracks instead of copying them
+	if (!ClimbActionSet)
+	{
+		AddLegacyClimbAction(FName("IdleToClimb"), IdleToClimbMontage, EClimbState::Entering, EClimbActionFollowUp::StartClimbing);
+		AddLegacyClimbAction(FName("ClimbDownLedge"), ClimbingDownLedgeMontage, EClimbState::Entering, EClimbActionFollowUp::StartClimbing);
+		AddLegacyClimbAction(FName("ClimbToTop"), ClimbingToTopMontage, EClimbState::Mantling, EClimbActionFollowUp::Walk);
+		AddLegacyClimbAction(FName("Vault"), ValutMontage, EClimbState::Vaulting, EClimbActionFollowUp::Walk, { FName("VaultStartPoint"), FName("VaultLandPoint") });
+		AddLegacyClimbAction(FName("HopUp"), HopUpMontage, EClimbState::Hopping, EClimbActionFollowUp::None, { FName("HopUpTargetPoint") });
+		AddLegacyClimbAction(FName("HopDown"), HopDownMontage, EClimbState::Hopping, EClimbActionFollowUp::None, { FName("HopDownTargetPoint") });
+		AddLegacyClimbAction(FName("HopRight"), HopRightMontage, EClimbState::Hopping, EClimbActionFollowUp::None, { FName("HopRightTargetPoint") });
+		AddLegacyClimbAction(FName("HopLeft"), HopLeftMontage, EClimbState::Hopping, EClimbActionFollowUp::None, { FName("HopLeftTargetPoint") });
+	}
+
+	const int32 NumActions = FMath::Min(ClimbActionSet ? ClimbActionSet->GetActions().Num() : LegacyClimbActions.Num(), (int32)MAX_uint8);
+
+	//Sizes the table GetClimbActions is capped to
+	ClimbActionMontages.Reset();
+	ClimbActionMontages.SetNum(NumActions);
+
+	const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+	ClimbActionIndexByName.Reset();
+	ClimbActionIndexByMontage.Reset();
+	bAllClimbActionsBaked = true;
+
+	for (int32 ActionIndex = 0; ActionIndex < NumActions; ActionIndex++)
+	{
+		ClimbActionIndexByName.Add(ClimbActions[ActionIndex].ActionName, (uint8)ActionIndex);
+		bAllClimbActionsBaked &= ClimbActions[ActionIndex].ServerRootMotion.IsValid();
+
+		//Montages something else already loaded are usable right away
+		if (UAnimMontage* Montage = ClimbActions[ActionIndex].Montage.Get())
+		{
+			ClimbActionMontages[ActionIndex] = Montage;
+			ClimbActionIndexByMontage.Add(Montage, (uint8)ActionIndex);
+		}
+	}
+}
+
+void UCustomMovementComponent::AddLegacyClimbAction(FName ActionName, UAnimMontage* Montage, EClimbState State, EClimbActionFollowUp FollowUp, TArray<FName>&& WarpTargetNames)
+{
+	FClimbActionDefinition& Action = LegacyClimbActions.AddDefaulted_GetRef();
+	Action.ActionName = ActionName;
+	Action.Montage = Montage;
+	Action.WarpTargetNames = MoveTemp(WarpTargetNames);
+	Action.State = State;
+	Action.FollowUp = FollowUp;
+}
+
+void UCustomMovementComponent::UpdateClimbActionStreaming(float DeltaTime)
+{
+	//Legacy montages are hard references and always resident
+	if (!ClimbActionSet || !UpdatedComponent) return;
+
+	if (bAllClimbActionsBaked && ShouldUseServerClimbActions()) return;
+
+	ClimbActionStreamTimer -= DeltaTime;
+	if (ClimbActionStreamTimer > 0.f) return;
+
+	ClimbActionStreamTimer = ClimbActionStreamCheckInterval;
+
+	const bool bInClimbAction = IsClimbing() || (OwningPlayerAnimInstance && OwningPlayerAnimInstance->IsAnyMontagePlaying());
+
+	const bool bNearClimbableSurface = bInClimbAction || GetWorld()->OverlapAnyTestByObjectType(
+		UpdatedComponent->GetComponentLocation(),
+		FQuat::Identity,
+		ClimbObjectQueryParams,
+		FCollisionShape::MakeSphere(ClimbActionStreamRadius),
+		ClimbQueryParams
+	);
+
+	if (bNearClimbableSurface)
+	{
+		ClimbActionReleaseTimer = ClimbActionReleaseDelay;
+		RequestClimbActionMontages();
+		return;
+	}
+
+	ClimbActionReleaseTimer -= ClimbActionStreamCheckInterval;
+	if (ClimbActionReleaseTimer <= 0.f)
+	{
+		ReleaseClimbActionMontages();
+	}
+}
+
+void UCustomMovementComponent::RequestClimbActionMontages()
+{
+	if (ClimbActionStreamHandle.IsValid()) return;
+
+	const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+
+	TArray<FSoftObjectPath> MontagePaths;
+	for (int32 ActionIndex = 0; ActionIndex < ClimbActions.Num(); ActionIndex++)
+	{
+		if (!ClimbActionMontages[ActionIndex] && !ClimbActions[ActionIndex].Montage.IsNull())
+		{
+			MontagePaths.Add(ClimbActions[ActionIndex].Montage.ToSoftObjectPath());
+		}
+	}
+
+	if (MontagePaths.IsEmpty()) return;
+
+	ClimbActionStreamHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MontagePaths,
+		FStreamableDelegate::CreateUObject(this, &UCustomMovementComponent::OnClimbActionMontagesLoaded)
+	);
+}
+
+void UCustomMovementComponent::OnClimbActionMontagesLoaded()
+{
+	const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+
+	for (int32 ActionIndex = 0; ActionIndex < ClimbActions.Num(); ActionIndex++)
+	{
+		if (ClimbActionMontages[ActionIndex]) continue;
+
+		if (UAnimMontage* Montage = ClimbActions[ActionIndex].Montage.Get())
+		{
+			ClimbActionMontages[ActionIndex] = Montage;
+			ClimbActionIndexByMontage.Add(Montage, (uint8)ActionIndex);
+		}
+	}
+}
+
+void UCustomMovementComponent::ReleaseClimbActionMontages()
+{
+	if (ClimbActionStreamHandle.IsValid())
+	{
+		ClimbActionStreamHandle->ReleaseHandle();
+		ClimbActionStreamHandle.Reset();
+	}
+
+	if (ClimbActionIndexByMontage.IsEmpty()) return;
+
+	for (TObjectPtr<UAnimMontage>& Montage : ClimbActionMontages)
+	{
+		Montage = nullptr;
+	}
+
+	ClimbActionIndexByMontage.Reset();
+}
+
+UAnimMontage* UCustomMovementComponent::ResolveClimbActionMontage(int32 ActionIndex)
+{
+	const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+	if (!ClimbActions.IsValidIndex(ActionIndex)) return nullptr;
+
+	if (ClimbActionMontages[ActionIndex]) return ClimbActionMontages[ActionIndex];
+
+	//The request came in before the stream finished, block on this one montage rather than drop the action
+	UAnimMontage* Montage = ClimbActions[ActionIndex].Montage.LoadSynchronous();
+	if (Montage)
+	{
+		ClimbActionMontages[ActionIndex] = Montage;
+		ClimbActionIndexByMontage.Add(Montage, (uint8)ActionIndex);
+	}
+
+	return Montage;
+}
+
+void UCustomMovementComponent::PlayClimbAction(FName ActionName, TConstArrayView<FVector> WarpTargetLocations)
+{
+	const uint8* ActionIndex = ClimbActionIndexByName.Find(ActionName);
+	if (!ActionIndex) return;
+
+	bool bStarted = false;
+
+	if (ShouldUseServerClimbActions())
+	{
+		bStarted = PlayServerClimbAction(*ActionIndex, WarpTargetLocations);
+	}
+	else if (UAnimMontage* Montage = ResolveClimbActionMontage(*ActionIndex))
+	{
+		const TArray<FName>& WarpTargetNames = GetClimbActions()[*ActionIndex].WarpTargetNames;
+		const int32 NumWarpTargets = FMath::Min(WarpTargetNames.Num(), WarpTargetLocations.Num());
+
+		for (int32 WarpIndex = 0; WarpIndex < NumWarpTargets; WarpIndex++)
+		{
+			SetMotionWarpTarget(WarpTargetNames[WarpIndex], WarpTargetLocations[WarpIndex]);
+		}
+
+		bStarted = PlayClimbMontage(Montage);
+	}
+
+	if (bStarted && CharacterOwner->HasAuthority())
+	{
+		ReplicateClimbTransition(*ActionIndex, WarpTargetLocations);
+	}
+}
+
+const FClimbActionDefinition* UCustomMovementComponent::FindClimbActionForMontage(const UAnimMontage* Montage) const
+{
+	const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+	const uint8* ActionIndex = ClimbActionIndexByMontage.Find(Montage);
+
+	return ActionIndex && ClimbActions.IsValidIndex(*ActionIndex) ? &ClimbActions[*ActionIndex] : nullptr;
+}
+
+void UCustomMovementComponent::OnClimbActionEnded(const FClimbActionDefinition* Action)
+{
+	//Simulated proxies get their movement mode from the server, they only replay the montage
+	if (Action && CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
+	{
+		switch (Action->FollowUp)
+		{
+		case EClimbActionFollowUp::StartClimbing:
+			StartClimbing();
+			StopMovementImmediately();
+			break;
+		case EClimbActionFollowUp::Walk:
+			SetMovementMode(MOVE_Walking);
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (ClimbState == EClimbState::Hopping && IsClimbing())
+	{
+		SetClimbState(EClimbState::Hanging);
+	}
+
+	//An entry montage that was cut short never reached the wall
+	if (ClimbState == EClimbState::Entering && !IsClimbing())
+	{
+		SetClimbState(EClimbState::None);
+	}
+}
+
+bool UCustomMovementComponent::ShouldUseServerClimbActions() const
+{
+	return bUseServerClimbActions && IsNetMode(NM_DedicatedServer);
+}
+
+const FClimbRootMotionTrack* UCustomMovementComponent::ResolveClimbRootMotionTrack(int32 ActionIndex)
+{
+	if (const FClimbRootMotionTrack* BakedTrack = GetClimbRootMotionTrack(ActionIndex)) return BakedTrack;
+
+	//Legacy montages and unsaved assets are baked on first use, into this component so the shared set is never written
+	const UAnimMontage* Montage = ResolveClimbActionMontage(ActionIndex);
+	if (!Montage) return nullptr;
+
+	RuntimeClimbRootMotionTracks.SetNum(GetClimbActions().Num());
+	RuntimeClimbRootMotionTracks[ActionIndex].Bake(*Montage, ServerRootMotionSampleRate);
+
+	return GetClimbRootMotionTrack(ActionIndex);
+}
+
+bool UCustomMovementComponent::PlayServerClimbAction(int32 ActionIndex, TConstArrayView<FVector> WarpTargetLocations)
+{
+	//Same rule as PlayClimbMontage, one transition at a time
+	if (ServerClimbActionIndex != INDEX_NONE) return false;
+
+	const FClimbRootMotionTrack* Track = ResolveClimbRootMotionTrack(ActionIndex);
+	if (!Track) return false;
+
+	const FClimbActionDefinition& Action = GetClimbActions()[ActionIndex];
+
+	TSharedPtr<FRootMotionSource_ClimbAction> RootMotionSource = MakeShared<FRootMotionSource_ClimbAction>();
+	RootMotionSource->InstanceName = Action.ActionName;
+	RootMotionSource->ActionIndex = (uint8)ActionIndex;
+	RootMotionSource->Duration = FMath::Max(Track->PlayLength - Track->BlendOutTime, UE_KINDA_SMALL_NUMBER);
+	RootMotionSource->StartLocation = UpdatedComponent->GetComponentLocation();
+	RootMotionSource->MeshRotation = CharacterOwner->GetMesh()->GetComponentQuat();
+	RootMotionSource->BuildWarpCorrections(*Track, Action.WarpTargetNames, WarpTargetLocations, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+
+	ServerClimbActionRootMotionID = ApplyRootMotionSource(RootMotionSource);
+	ServerClimbActionIndex = ActionIndex;
+
+	if (Action.State != EClimbState::None)
+	{
+		SetClimbState(Action.State);
+	}
+
+	return true;
+}
+
+void UCustomMovementComponent::ReplicateClimbTransition(int32 ActionIndex, TConstArrayView<FVector> WarpTargetLocations)
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const FVector CharacterLocation = CharacterOwner->GetActorLocation();
+
+	ReplicatedClimbTransition.ActionId = (uint8)ActionIndex;
+	ReplicatedClimbTransition.Sequence++;
+	ReplicatedClimbTransition.ServerTimestamp = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	ReplicatedClimbTransition.StartLocation = CharacterLocation;
+	ReplicatedClimbTransition.WarpTargetOffsets.Reset();
+
+	const int32 NumWarpTargets = FMath::Min(WarpTargetLocations.Num(), MaxClimbTransitionWarpTargets);
+	for (int32 WarpIndex = 0; WarpIndex < NumWarpTargets; WarpIndex++)
+	{
+		ReplicatedClimbTransition.WarpTargetOffsets.Add(WarpTargetLocations[WarpIndex] - CharacterLocation);
+	}
+}
+
+void UCustomMovementComponent::OnRep_ClimbTransition()
+{
+	if (!CharacterOwner || CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy) return;
+
+	const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+	if (!ClimbActions.IsValidIndex(ReplicatedClimbTransition.ActionId)) return;
+
+	const int32 ActionIndex = ReplicatedClimbTransition.ActionId;
+
+	UAnimMontage* Montage = ResolveClimbActionMontage(ActionIndex);
+	if (!Montage) return;
+
+	//Join the montage where the server is now, a transition that is already over is not worth starting
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const float ServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	const float StartTime = FMath::Max(ServerTime - ReplicatedClimbTransition.ServerTimestamp, 0.f);
+
+	if (StartTime >= Montage->GetPlayLength()) return;
+
+	//Rebuilt from where the server started the action, a late event finds the proxy already part of the way there
+	const FVector StartLocation = ReplicatedClimbTransition.StartLocation;
+	const TArray<FName>& WarpTargetNames = ClimbActions[ActionIndex].WarpTargetNames;
+	const int32 NumWarpTargets = FMath::Min(WarpTargetNames.Num(), ReplicatedClimbTransition.WarpTargetOffsets.Num());
+
+	for (int32 WarpIndex = 0; WarpIndex < NumWarpTargets; WarpIndex++)
+	{
+		SetMotionWarpTarget(WarpTargetNames[WarpIndex], StartLocation + ReplicatedClimbTransition.WarpTargetOffsets[WarpIndex]);
+	}
+
+	//A newer transition replaces whatever the proxy is still showing
+	if (OwningPlayerAnimInstance)
+	{
+		OwningPlayerAnimInstance->StopAllMontages(0.1f);
+	}
+
+	PlayClimbMontage(Montage, StartTime);
+}
+
+bool UCustomMovementComponent::IsClimbActionReplicatedAsEvent() const
+{
+	if (!CharacterOwner || !CharacterOwner->HasAuthority()) return false;
+
+	//Montage free server actions are a single root motion source of their own
+	if (ServerClimbActionIndex != INDEX_NONE)
+	{
+		return CurrentRootMotion.RootMotionSources.Num() == 1;
+	}
+
+	const FAnimMontageInstance* MontageInstance = CharacterOwner->GetRootMotionAnimMontageInstance();
+	return MontageInstance && FindClimbActionForMontage(MontageInstance->Montage) && !CurrentRootMotion.HasActiveRootMotionSources();
+}
+
+void UCustomMovementComponent::UpdateServerClimbAction()
+{
+	if (ServerClimbActionIndex == INDEX_NONE) return;
+
+	const TSharedPtr<FRootMotionSource> RootMotionSource = GetRootMotionSourceByID(ServerClimbActionRootMotionID);
+	if (RootMotionSource.IsValid() && !RootMotionSource->Status.HasFlag(ERootMotionSourceStatusFlags::Finished)) return;
+
+	const int32 FinishedActionIndex = ServerClimbActionIndex;
+	ServerClimbActionIndex = INDEX_NONE;
+	ServerClimbActionRootMotionID = 0;
+
+	const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+	OnClimbActionEnded(ClimbActions.IsValidIndex(FinishedActionIndex) ? &ClimbActions[FinishedActionIndex] : nullptr);
+}
+
+#pragma endregion
+
+#pragma region ClimbCore
+
+void UCustomMovementComponent::ToggleClimbing(bool bEnableClimb)
+{
+	if (bEnableClimb)
+	{
+		bWantsToStartClimbing = true;
+	}
+	else
+	{
+		bWantsToStopClimbing = true;
+	}
+}
+
+void UCustomMovementComponent::ExecuteToggleClimbing(bool bEnableClimb)
+{
+	RequestFullClimbFidelity(ClimbLODTransitionHoldTime);
+
+	//Nothing to decide while an entry montage is already taking the character onto the wall
+	if (bEnableClimb && ClimbState == EClimbState::Entering) return;
+
+	if (bEnableClimb)
+	{
+		RefreshClimbQueryFrame();
+
+		if (bUseAsyncClimbEntryProbes)
+		{
+			RequestClimbEntryProbes();
+		}
+		else if (CanStartClimbing())
+		{
+			PlayClimbAction(FName("IdleToClimb"));
+		}
+		else if(CanClimbDownLedge())
+		{
+			PlayClimbAction(FName("ClimbDownLedge"));
+		}
+		else
+		{
+			TryStartVaulting();
+		}
+	}
+	
+	if (!bEnableClimb)
+	{
+		StopClimbing();
+	}
+}
+
+bool UCustomMovementComponent::CanStartClimbing()
+{
+	if (IsFalling()) return false;
+	if (!TraceClimbableSurfaces()) return false;
+	if (!TraceFromEyeHeight(100.f).bBlockingHit) return false;
+
+	return true;
+}
+
+bool UCustomMovementComponent::CanClimbDownLedge()
+{
+	if (IsFalling()) return false;
+
+	const FVector ComponentLocation = ClimbQueryFrame.Location;
+	const FVector ComponentForward = ClimbQueryFrame.Forward;
+	const FVector DownVector = -ClimbQueryFrame.Up;
+
+	const FVector WalkableSurfaceTraceStart = ComponentLocation + ComponentForward * ClimbDownWalkableSurfaceTraceOffset;
+	const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 100.f;
+
+	FHitResult WalkableSurfaceHit = DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd);
+
+	const FVector LedgeTraceStart = WalkableSurfaceHit.TraceStart + ComponentForward * ClimbDownLedgeTraceOffset;
+	const FVector LedgeTraceEnd = LedgeTraceStart + DownVector * 200.f;
+
+	FHitResult LedgeTraceHit = DoLineTraceSingleByObject(LedgeTraceStart, LedgeTraceEnd);
+
+	if (WalkableSurfaceHit.bBlockingHit && !LedgeTraceHit.bBlockingHit)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void UCustomMovementComponent::StartClimbing()
+{
+	SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_Climb);
+}
+
+void UCustomMovementComponent::StopClimbing()
+{
+	SetMovementMode(MOVE_Falling);
+}
+
+void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
+{
+	CLIMB_SCOPE_CYCLE_COUNTER(PhysClimb);
+
+	if (deltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	//Batched climbers are integrated by UClimbBatchSubsystem, root motion still runs here
+	if (ClimbBatchIndex != INDEX_NONE && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		return;
+	}
+
+	RefreshClimbQueryFrame();
+
+	ActiveClimbProbes = ResolveClimbProbes();
+
+	//Montages drive their own timing, only free climbing is stepped at the fixed rate
+	const bool bFixedStep = bUseFixedClimbStep && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity();
+	const float StepTime = 1.f / FMath::Max(ClimbSubstepRate, 1.f);
+
+	int32 NumSteps = 1;
+	if (bFixedStep)
+	{
+		ClimbStepAccumulator += deltaTime;
+		NumSteps = FMath::Min(FMath::FloorToInt32(ClimbStepAccumulator / StepTime), MaxClimbSubstepsPerFrame);
+
+		//Nothing moves on a frame without a step, so there is nothing new to probe either
+		if (NumSteps == 0)
+		{
+			ActiveClimbProbes &= ~(ClimbProbes::Surface | ClimbProbes::StopCheck | ClimbProbes::Floor | ClimbProbes::Ledge);
+		}
+	}
+
+	//Process all the climbable surface info
+	if ((ActiveClimbProbes & ClimbProbes::Surface) && !TryAnalyticClimbableSurface() && !TryReuseClimbableSurface())
+	{
+		TraceClimbableSurfaces();
+		ProcessClimbableSurfaceInfo(deltaTime);
+		CacheClimbableSurface();
+		CacheAnalyticClimbSurface();
+	}
+
+	//Check if should stop climbing
+	if (((ActiveClimbProbes & ClimbProbes::StopCheck) && CheckShouldStopClimbing()) ||
+		((ActiveClimbProbes & ClimbProbes::Floor) && CheckHasReachedFloor()))
+	{
+		StopClimbing();
+	}
+
+	if (bFixedStep)
+	{
+		for (int32 StepIndex = 0; StepIndex < NumSteps; StepIndex++)
+		{
+			//The surface traced above is reused by every substep
+			ClimbStepPreviousTransform = UpdatedComponent->GetComponentTransform();
+			bHasClimbStepInterpolation = true;
+
+			IntegrateClimbStep(StepTime);
+
+			ClimbStepAccumulator -= StepTime;
+		}
+
+		//Past the cap the leftover time is dropped rather than owed to the next frame
+		ClimbStepAccumulator = FMath::Fmod(ClimbStepAccumulator, StepTime);
+	}
+	else
+	{
+		ClimbStepAccumulator = 0.f;
+		bHasClimbStepInterpolation = false;
+
+		IntegrateClimbStep(deltaTime);
+	}
+
+	if (!(ActiveClimbProbes & ClimbProbes::Ledge)) return;
+
+	//Ledge probes run from where the character ended up this tick
+	RefreshClimbQueryFrame();
+
+	if (CheckHasReachedLedge())
+	{
+		PlayClimbAction(FName("ClimbToTop"));
+	}
+}
+
+void UCustomMovementComponent::IntegrateClimbStep(float StepTime)
+{
+	RestorePreAdditiveRootMotionVelocity();
+
+	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		//Define Max climb speed and acceleration
+		CalcVelocity(StepTime, 0.f, true, MaxBreakClimbDecelation);
+	}
+
+	ApplyRootMotionToVelocity(StepTime);
+
+	FVector OldLocation = UpdatedComponent->GetComponentLocation();
+
+	//Snap to the climbable surface in the same sweep as the climb move, only refined on frames that traced it
+	const bool bSnapToSurface = (ActiveClimbProbes & ClimbProbes::Snap) != 0;
+	const FVector Adjusted = Velocity * StepTime + (bSnapToSurface ? GetClimbSnapDelta(StepTime) : FVector::ZeroVector);
+	FHitResult Hit(1.f);
+
+	//Handle climb rotation
+	SafeMoveUpdatedComponent(Adjusted, GetClimbRotation(StepTime), true, Hit);
+
+	if (Hit.Time < 1.f)
+	{
+		//adjust and try again
+		HandleImpact(Hit, StepTime, Adjusted);
+		SlideAlongSurface(Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
+	}
+
+	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / StepTime;
+
+		//The snap only pulls along the surface normal, keep it out of the climb velocity
+		if (bSnapToSurface)
+		{
+			Velocity = FVector::VectorPlaneProject(Velocity, CurrentClimbableSurfaceNormal);
+		}
+	}
+}
+
+void UCustomMovementComponent::UpdateClimbStepInterpolation()
+{
+	USkeletalMeshComponent* CharacterMesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr;
+	if (!CharacterMesh) return;
+
+	const bool bShouldInterpolate =
+		bHasClimbStepInterpolation && IsClimbing() &&
+		CharacterOwner->IsLocallyControlled();
+
+	if (!bShouldInterpolate)
+	{
+		if (bClimbMeshInterpolated)
+		{
+			CharacterMesh->SetRelativeLocationAndRotation(CharacterOwner->GetBaseTranslationOffset(), CharacterOwner->GetBaseRotationOffset());
+			bClimbMeshInterpolated = false;
+		}
+		return;
+	}
+
+	//Draw the mesh between the last two substeps by how far the accumulator is into the next one
+	const float Alpha = FMath::Clamp(ClimbStepAccumulator * ClimbSubstepRate, 0.f, 1.f);
+
+	const FTransform& CurrentTransform = UpdatedComponent->GetComponentTransform();
+	const FVector InterpolatedLocation = FMath::Lerp(ClimbStepPreviousTransform.GetLocation(), CurrentTransform.GetLocation(), Alpha);
+	const FQuat InterpolatedQuat = FQuat::Slerp(ClimbStepPreviousTransform.GetRotation(), CurrentTransform.GetRotation(), Alpha);
+
+	const FQuat InverseCurrentQuat = CurrentTransform.GetRotation().Inverse();
+	const FVector MeshWorldLocation = InterpolatedLocation + InterpolatedQuat.RotateVector(CharacterOwner->GetBaseTranslationOffset());
+
+	CharacterMesh->SetRelativeLocationAndRotation(
+		InverseCurrentQuat.RotateVector(MeshWorldLocation - CurrentTransform.GetLocation()),
+		InverseCurrentQuat * InterpolatedQuat * CharacterOwner->GetBaseRotationOffset()
+	);
+	bClimbMeshInterpolated = true;
+}
+
+void UCustomMovementComponent::ProcessClimbableSurfaceInfo(float DeltaTime)
+{
+	CLIMB_SCOPE_CYCLE_COUNTER(ProcessClimbableSurfaceInfo);
+
+	if (!bUseRobustSurfaceFit)
+	{
+		ClimbableSurfaceHits.ReduceCentroidAndNormal(CurrentClimbableSurfaceLocation, CurrentClimbableSurfaceNormal);
+		ClimbSurfaceConfidence = ClimbableSurfaceHits.IsEmpty() ? 0.f : 1.f;
+		return;
+	}
+
+	FClimbSurfaceFitSettings FitSettings;
+	FitSettings.MinNormalDot = FMath::Cos(FMath::DegreesToRadians(SurfaceFitOutlierAngle));
+	FitSettings.ResidualScale = SurfaceFitResidualScale;
+
+	FClimbSurfaceFit Fit;
+	if (!ClimbableSurfaceHits.FitPlane(FitSettings, Fit))
+	{
+		CurrentClimbableSurfaceLocation = FVector::ZeroVector;
+		CurrentClimbableSurfaceNormal = FVector::ZeroVector;
+		ClimbSurfaceConfidence = 0.f;
+		bHasFilteredClimbSurface = false;
+		return;
+	}
+
+	FilterClimbSurfaceFit(Fit, DeltaTime);
+}
+
+void UCustomMovementComponent::FilterClimbSurfaceFit(const FClimbSurfaceFit& Fit, float DeltaTime)
+{
+	const float ResetDot = FMath::Cos(FMath::DegreesToRadians(SurfaceFilterResetAngle));
+
+	if (!bHasFilteredClimbSurface || FVector::DotProduct(Fit.Normal, FilteredClimbSurfaceNormal) < ResetDot)
+	{
+		FilteredClimbSurfaceNormal = Fit.Normal;
+		FilteredClimbSurfaceAnchor = Fit.Location;
+		bHasFilteredClimbSurface = true;
+	}
+	else
+	{
+		const float Alpha = 1.f - FMath::Exp(-SurfaceFilterRate * Fit.Confidence * DeltaTime);
+
+		FilteredClimbSurfaceNormal = FMath::Lerp(FilteredClimbSurfaceNormal, Fit.Normal, Alpha).GetSafeNormal();
+
+		//Keep the fitted point's position along the surface, only close part of its depth off the filtered plane
+		const double FitDepth = FVector::DotProduct(FilteredClimbSurfaceNormal, Fit.Location - FilteredClimbSurfaceAnchor);
+		FilteredClimbSurfaceAnchor = Fit.Location - FilteredClimbSurfaceNormal * (FitDepth * (1.0 - Alpha));
+	}
+
+	CurrentClimbableSurfaceLocation = FilteredClimbSurfaceAnchor;
+	CurrentClimbableSurfaceNormal = FilteredClimbSurfaceNormal;
+	ClimbSurfaceConfidence = Fit.Confidence;
+}
+
+void UCustomMovementComponent::UpdateClimbAnimSnapshot()
+{
+	ClimbAnimSnapshot.Velocity = Velocity;
+	ClimbAnimSnapshot.Acceleration = GetCurrentAcceleration();
+	ClimbAnimSnapshot.UnrotatedClimbVelocity = UpdatedComponent->GetComponentQuat().UnrotateVector(Velocity);
+	ClimbAnimSnapshot.bIsFalling = IsFalling();
+	ClimbAnimSnapshot.bIsClimbing = IsClimbing();
+	ClimbAnimSnapshot.AvailableHops = GetAvailableHops();
+}
+
+bool UCustomMovementComponent::PrepareBatchedClimbStep(float DeltaTime)
+{
+	if (!IsClimbing()) return false;
+	if (HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity()) return false;
+
+	RefreshClimbQueryFrame();
+
+	ActiveClimbProbes = ResolveClimbProbes();
+
+	if ((ActiveClimbProbes & ClimbProbes::Surface) && !TryAnalyticClimbableSurface() && !TryReuseClimbableSurface())
+	{
+		TraceClimbableSurfaces();
+		ProcessClimbableSurfaceInfo(DeltaTime);
+		CacheClimbableSurface();
+		CacheAnalyticClimbSurface();
+	}
+
+	if (((ActiveClimbProbes & ClimbProbes::StopCheck) && CheckShouldStopClimbing()) ||
+		((ActiveClimbProbes & ClimbProbes::Floor) && CheckHasReachedFloor()))
+	{
+		StopClimbing();
+		return false;
+	}
+
+	return true;
+}
+
+void UCustomMovementComponent::FinishBatchedClimbStep(const FVector& MoveDelta, const FVector& NewVelocity, const FQuat& NewRotation, float DeltaTime)
+{
+	//Batched climbers move outside PerformMovement, so defer overlaps and child transforms here instead
+	FScopedMovementUpdate ScopedBatchedMove(UpdatedComponent, EScopedUpdate::DeferredUpdates);
+
+	FHitResult Hit(1.f);
+	SafeMoveUpdatedComponent(MoveDelta, NewRotation, true, Hit);
+
+	if (Hit.Time < 1.f)
+	{
+		HandleImpact(Hit, DeltaTime, MoveDelta);
+		SlideAlongSurface(MoveDelta, (1.f - Hit.Time), Hit.Normal, Hit, true);
+	}
+
+	Velocity = NewVelocity;
+
+	if (!(ActiveClimbProbes & ClimbProbes::Ledge)) return;
+
+	RefreshClimbQueryFrame();
+
+	if (CheckHasReachedLedge())
+	{
+		PlayClimbAction(FName("ClimbToTop"));
+	}
+}
+
+void UCustomMovementComponent::UpdateClimbBatchRegistration()
+{
+	const bool bShouldBatch =
+		bUseBatchedClimbMovement &&
+		IsClimbing() &&
+		CharacterOwner &&
+		!CharacterOwner->IsPlayerControlled() &&
+		CharacterOwner->GetLocalRole() == ROLE_Authority;
+
+	if (bShouldBatch == (ClimbBatchIndex != INDEX_NONE)) return;
+
+	UClimbBatchSubsystem* BatchSubsystem = GetWorld()->GetSubsystem<UClimbBatchSubsystem>();
+	if (!BatchSubsystem) return;
+
+	if (bShouldBatch)
+	{
+		ClimbBatchIndex = BatchSubsystem->RegisterClimber(this);
+	}
+	else
+	{
+		BatchSubsystem->UnregisterClimber(this);
+		ClimbBatchIndex = INDEX_NONE;
+	}
+}
+
+bool UCustomMovementComponent::TryReuseClimbableSurface()
+{
+	if (!bUseClimbSurfaceCache || !ClimbSurfaceCache.bValid) return false;
+
+	//Corrections replay with full sweeps so they match what the server simulated
+	if (CharacterOwner->bClientUpdating) return false;
+
+	ClimbSurfaceCache.bValid = false;
+
+	UPrimitiveComponent* CachedPrimitive = ClimbSurfaceCache.Primitive.Get();
+	if (!CachedPrimitive) return false;
+
+	if (GetWorld()->GetTimeSeconds() - ClimbSurfaceCache.SweepTime > ClimbSurfaceCacheMaxTime) return false;
+	if (FVector::DistSquared(ClimbQueryFrame.Location, ClimbSurfaceCache.SweepLocation) > FMath::Square(ClimbSurfaceCacheMaxDistance)) return false;
+
+	//Probe straight at the cached plane, it has to be the same primitive with the same facing
+	const FVector SurfaceNormal = ClimbSurfaceCache.SurfaceNormal;
+	const float DistanceToPlane = FVector::DotProduct(ClimbQueryFrame.Location - ClimbSurfaceCache.SurfaceLocation, SurfaceNormal);
+
+	const FVector Start = ClimbQueryFrame.Location;
+	const FVector End = Start - SurfaceNormal * (DistanceToPlane + ClimbCapsuleTraceRadius);
+
+	const FHitResult SurfaceHit = DoLineTraceSingleByObject(Start, End);
+
+	if (!SurfaceHit.bBlockingHit || SurfaceHit.GetComponent() != CachedPrimitive) return false;
+	if (FVector::DotProduct(SurfaceHit.ImpactNormal, SurfaceNormal) < ClimbSurfaceCacheNormalTolerance) return false;
 
-	FHitResult LedgeTraceHit = DoLineTraceSingleByObject(LedgeTraceStart, LedgeTraceEnd);
+	//Slide the cached surface point along the plane with the character and onto the probed plane
+	FVector SurfaceLocation = ClimbSurfaceCache.SurfaceLocation + FVector::VectorPlaneProject(ClimbQueryFrame.Location - ClimbSurfaceCache.SweepLocation, SurfaceNormal);
+	SurfaceLocation += SurfaceNormal * FVector::DotProduct(SurfaceHit.ImpactPoint - SurfaceLocation, SurfaceNormal);
 
-	if (WalkableSurfaceHit.bBlockingHit && !LedgeTraceHit.bBlockingHit)
-	{
-		return true;
-	}
+	CurrentClimbableSurfaceLocation = SurfaceLocation;
+	CurrentClimbableSurfaceNormal = SurfaceNormal;
 
-	return false;
+	ClimbSurfaceCache.bValid = true;
+	return true;
 }
 
-void UCustomMovementComponent::StartClimbing()
+void UCustomMovementComponent::CacheClimbableSurface()
 {
-	SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_Climb);
-}
+	ClimbSurfaceCache.bValid = false;
 
-void UCustomMovementComponent::StopClimbing()
-{
-	SetMovementMode(MOVE_Falling);
-}
+	if (!bUseClimbSurfaceCache || ClimbableSurfaceHits.IsEmpty()) return;
 
-void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
-{
-	if (deltaTime < MIN_TICK_TIME)
-	{
-		return;
-	}
+	//Only a single flat primitive can be tracked with one probe
+	if (ClimbableSurfaceHits.GetNumPrimitives() != 1) return;
 
-	//Process all the climbable surface info
-	TraceClimbableSurfaces();
-	ProcessClimbableSurfaceInfo();
+	UPrimitiveComponent* SurfacePrimitive = ClimbableSurfaceHits.GetPrimitive(0);
+	if (!SurfacePrimitive) return;
 
-	//Check if should stop climbing
-	if (CheckShouldStopClimbing() || CheckHasReachedFloor())
+	for (int32 HitIndex = 0; HitIndex < ClimbableSurfaceHits.Num(); HitIndex++)
 	{
-		StopClimbing();
+		if (FVector::DotProduct(ClimbableSurfaceHits.GetNormal(HitIndex), CurrentClimbableSurfaceNormal) < ClimbSurfaceCacheNormalTolerance) return;
 	}
 
-	RestorePreAdditiveRootMotionVelocity();
+	ClimbSurfaceCache.Primitive = SurfacePrimitive;
+	ClimbSurfaceCache.SurfaceLocation = CurrentClimbableSurfaceLocation;
+	ClimbSurfaceCache.SurfaceNormal = CurrentClimbableSurfaceNormal;
+	ClimbSurfaceCache.SweepLocation = ClimbQueryFrame.Location;
+	ClimbSurfaceCache.SweepTime = GetWorld()->GetTimeSeconds();
+	ClimbSurfaceCache.bValid = true;
+}
 
-	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
-	{
-		//Define Max climb speed and acceleration
-		CalcVelocity(deltaTime, 0.f, true, MaxBreakClimbDecelation);
-	}
+bool UCustomMovementComponent::IsAnalyticClimbSurfaceUsable()
+{
+	if (!bUseAnalyticClimbSurface || !AnalyticClimbSurface.IsValid()) return false;
 
-	ApplyRootMotionToVelocity(deltaTime);
+	//Corrections replay with full sweeps so they match what the server simulated
+	if (CharacterOwner->bClientUpdating) return false;
 
-	FVector OldLocation = UpdatedComponent->GetComponentLocation();
-	const FVector Adjusted = Velocity * deltaTime;
-	FHitResult Hit(1.f);
+	if (GetWorld()->GetTimeSeconds() - AnalyticClimbSurface.SweepTime > AnalyticClimbRevalidateTime) return false;
+	if (FVector::DistSquared(ClimbQueryFrame.Location, AnalyticClimbSurface.SweepLocation) > FMath::Square(AnalyticClimbRevalidateDistance)) return false;
 
-	//Handle climb rotation
-	SafeMoveUpdatedComponent(Adjusted, GetClimbRotation(deltaTime), true, Hit);
+	return AnalyticClimbSurface.Refresh();
+}
 
-	if (Hit.Time < 1.f)
-	{
-		//adjust and try again
-		HandleImpact(Hit, deltaTime, Adjusted);
-		SlideAlongSurface(Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
-	}
+bool UCustomMovementComponent::TryAnalyticClimbableSurface()
+{
+	if (!IsAnalyticClimbSurfaceUsable()) return false;
 
-	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
-	{
-		Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
-	}
+	FVector SurfaceLocation = ClimbQueryFrame.Location;
+	FVector SurfaceNormal = FVector::ZeroVector;
 
-	//Snap movement to climbable surface
-	SnapMovementToClimbableSurfaces(deltaTime);
+	const bool bOnFace = AnalyticClimbSurface.FindSurface(ClimbQueryFrame.Location, AnalyticClimbEdgeMargin, SurfaceLocation, SurfaceNormal);
 
-	if (CheckHasReachedLedge())
-	{
-		PlayClimbMontage(ClimbingToTopMontage);
-	}
-}
+	ClimbStats::RecordProbe(EClimbProbeShape::Analytic, ClimbQueryFrame.Location, SurfaceLocation, bOnFace ? 1 : 0);
 
-void UCustomMovementComponent::ProcessClimbableSurfaceInfo()
-{
-	CurrentClimbableSurfaceLocation = FVector::ZeroVector;
-	CurrentClimbableSurfaceNormal = FVector::ZeroVector;
+	if (!bOnFace) return false;
 
-	if (ClimbableSurfacesTracedResults.IsEmpty()) return;
+	CurrentClimbableSurfaceLocation = SurfaceLocation;
+	CurrentClimbableSurfaceNormal = SurfaceNormal;
+	ClimbSurfaceConfidence = 1.f;
 
-	for (const FHitResult& TracedHitResult : ClimbableSurfacesTracedResults)
-	{
-		CurrentClimbableSurfaceLocation += TracedHitResult.ImpactPoint;
-		CurrentClimbableSurfaceNormal += TracedHitResult.ImpactNormal;
-	}
+	//The exact face seeds the filter, so the first traced frame after it blends from here instead of a stale fit
+	FilteredClimbSurfaceNormal = SurfaceNormal;
+	FilteredClimbSurfaceAnchor = SurfaceLocation;
+	bHasFilteredClimbSurface = true;
 
-	CurrentClimbableSurfaceLocation /= ClimbableSurfacesTracedResults.Num();
-	CurrentClimbableSurfaceNormal = CurrentClimbableSurfaceNormal.GetSafeNormal();
+	return true;
 }
 
-bool UCustomMovementComponent::CheckShouldStopClimbing()
+void UCustomMovementComponent::CacheAnalyticClimbSurface()
 {
-	if (ClimbableSurfacesTracedResults.IsEmpty()) return true;
+	if (!bUseAnalyticClimbSurface) return;
 
-	const float DotResult = FVector::DotProduct(CurrentClimbableSurfaceNormal, FVector::UpVector);
-	const float DegreeDiff = FMath::RadiansToDegrees(FMath::Acos(DotResult));
-	if (DegreeDiff <= 60.f)
+	//Anything else in reach could change the answer, only a lone primitive is handled analytically
+	UPrimitiveComponent* SurfacePrimitive = ClimbableSurfaceHits.GetNumPrimitives() == 1 ? ClimbableSurfaceHits.GetPrimitive(0) : nullptr;
+	if (!SurfacePrimitive)
 	{
-		return true;
+		AnalyticClimbSurface.Reset();
+		return;
 	}
 
-	return false;
+	//Climbing on along the same primitive keeps its planes, they only follow the component transform
+	if (AnalyticClimbSurface.GetPrimitive() != SurfacePrimitive && !AnalyticClimbSurface.Build(*SurfacePrimitive, AnalyticClimbPlanarTag)) return;
+
+	AnalyticClimbSurface.SweepLocation = ClimbQueryFrame.Location;
+	AnalyticClimbSurface.SweepTime = GetWorld()->GetTimeSeconds();
+}
+
+bool UCustomMovementComponent::CheckShouldStopClimbing()
+{
+	return ClimbDecision::ShouldStopClimbing(!ClimbableSurfaceHits.IsEmpty(), ToClimbDecisionVector(CurrentClimbableSurfaceNormal));
 }
 
 bool UCustomMovementComponent::CheckHasReachedFloor()
 {
-	const FVector DownVector = -UpdatedComponent->GetUpVector();
+	CLIMB_SCOPE_CYCLE_COUNTER(CheckHasReachedFloor);
+
+	//No floor can stop a climber that is not moving down, HasReachedFloor would reject every hit anyway
+	if (!ClimbDecision::IsDescendingToFloor(GetUnrotatedClimbVelocity().Z)) return false;
+
+	const FVector DownVector = -ClimbQueryFrame.Up;
 	const FVector StartOffSet = DownVector * 50.f;
 
-	const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffSet;
+	const FVector Start = ClimbQueryFrame.Location + StartOffSet;
 	const FVector End = Start + DownVector;
 
-	TArray<FHitResult> PossibleFloorHits = DoCapsuleTraceMultiByObject(Start, End);
+	//The climbed primitive stands on the floor and nothing else was in reach of the last sweep, so well above its bottom face there is no floor
+	if (IsAnalyticClimbSurfaceUsable())
+	{
+		float BottomDistance = 0.f;
+		const bool bHasBottom = AnalyticClimbSurface.FindBottomFaceDistance(Start, DownVector, BottomDistance);
+		const bool bAboveFloor = bHasBottom && BottomDistance > ClimbCapsuleTraceHalfHeight + AnalyticClimbEdgeMargin;
 
-	if (PossibleFloorHits.IsEmpty()) return false;
+		ClimbStats::RecordProbe(EClimbProbeShape::Analytic, Start, bHasBottom ? Start + DownVector * BottomDistance : End, bAboveFloor ? 0 : 1);
 
-	for (const FHitResult& PossibleFloorHit : PossibleFloorHits)
-	{
-		const bool bFloorReached = 
-			FVector::Parallel(-PossibleFloorHit.ImpactNormal, FVector::UpVector) &&
-			GetUnrotatedClimbVelocity().Z < -10.f; // going down
+		if (bAboveFloor) return false;
+	}
 
-		if (bFloorReached)
-		{
-			return true;
-		}
+	if (!DoCapsuleTraceMultiByObject(Start, End, FloorHits)) return false;
+
+	TArray<ClimbDecision::FVec3, TInlineAllocator<8>> FloorNormals;
+	FloorNormals.Reserve(FloorHits.Num());
+
+	for (int32 HitIndex = 0; HitIndex < FloorHits.Num(); HitIndex++)
+	{
+		FloorNormals.Add(ToClimbDecisionVector(FloorHits.GetNormal(HitIndex)));
 	}
 
-	return false;
+	return ClimbDecision::HasReachedFloor(FloorNormals.GetData(), FloorNormals.Num(), GetUnrotatedClimbVelocity().Z);
 }
 
 FQuat UCustomMovementComponent::GetClimbRotation(float DeltaTime)
@@ -371,38 +1776,68 @@ FQuat UCustomMovementComponent::GetClimbRotation(float DeltaTime)
 	return FMath::QInterpTo(CurrentQuat, TargetQuat, DeltaTime, 5.f);
 }
 
-void UCustomMovementComponent::SnapMovementToClimbableSurfaces(float DeltaTime)
+FVector UCustomMovementComponent::GetClimbSnapDelta(float DeltaTime) const
 {
 	const FVector ComponentForward = UpdatedComponent->GetForwardVector();
 	const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
 
 	const FVector ProjectedCharacterToSurface = (CurrentClimbableSurfaceLocation - ComponentLocation).ProjectOnTo(ComponentForward);
-	const FVector SnapVector = -CurrentClimbableSurfaceNormal * ProjectedCharacterToSurface.Length();
+	const double DistanceToSurface = ProjectedCharacterToSurface.Length();
 
-	UpdatedComponent->MoveComponent(
-		SnapVector * DeltaTime * MaxClimbSpeed,
-		UpdatedComponent->GetComponentQuat(),
-		true
-	);
+	//Shares the sweep with the climb move, so stop the capsule at the surface instead of relying on the sweep to block it
+	const double SkinDistance = FMath::Max(DistanceToSurface - CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), 0.0);
+	const double SnapDistance = FMath::Min(DistanceToSurface * DeltaTime * MaxClimbSpeed, SkinDistance);
+
+	return -CurrentClimbableSurfaceNormal * SnapDistance;
 }
 
 bool UCustomMovementComponent::CheckHasReachedLedge()
 {
-	FHitResult LedgeHitResult = TraceFromEyeHeight(100.f, 30.f);
+	CLIMB_SCOPE_CYCLE_COUNTER(CheckHasReachedLedge);
+
+	const float LedgeProbeDistance = 100.f;
+	const float LedgeProbeOffset = 30.f;
+
+	//The eye probe entering the climbed primitive means the wall goes on above, the trace could only hit the same or something nearer
+	if (IsAnalyticClimbSurfaceUsable())
+	{
+		const FVector EyeProbeStart = ClimbQueryFrame.Location + ClimbQueryFrame.Up * (CharacterOwner->BaseEyeHeight + LedgeProbeOffset);
+		const FVector EyeProbeEnd = EyeProbeStart + ClimbQueryFrame.Forward * LedgeProbeDistance;
+
+		const bool bEyeProbeHit = AnalyticClimbSurface.IntersectsSegment(EyeProbeStart, EyeProbeEnd);
+
+		ClimbStats::RecordProbe(EClimbProbeShape::Analytic, EyeProbeStart, EyeProbeEnd, bEyeProbeHit ? 1 : 0);
+
+		if (bEyeProbeHit) return false;
+	}
+
+	FHitResult LedgeHitResult = TraceFromEyeHeight(LedgeProbeDistance, LedgeProbeOffset);
 
 	if (!LedgeHitResult.bBlockingHit)
 	{
 		const FVector WalkableSurfaceTraceStart = LedgeHitResult.TraceEnd;
 
-		const FVector DownVector = -UpdatedComponent->GetUpVector();
+		const FVector DownVector = -ClimbQueryFrame.Up;
 		const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 100.f;
 
-		FHitResult WalkableSurfaceHitResult = DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd);
+		bool bHasWalkableSurface = false;
+
+		//A baked ledge along the probe stands in for the walkable surface trace, with the trace's own length
+		const UClimbSurfaceGraph* BakedGraph = GetBakedClimbGraph();
+		const FVector WalkableSurfaceTraceCenter = (WalkableSurfaceTraceStart + WalkableSurfaceTraceEnd) * 0.5f;
+		if (BakedGraph && BakedGraph->HasCoverage(WalkableSurfaceTraceCenter, 50.f + BakedClimbGraphTolerance))
+		{
+			int32 LedgeNodeIndex;
+			bHasWalkableSurface = BakedGraph->FindNodeAlongRay(WalkableSurfaceTraceStart, DownVector, 100.f, BakedClimbGraphTolerance, EClimbGraphNodeType::Ledge, LedgeNodeIndex);
 
-		if (WalkableSurfaceHitResult.bBlockingHit && GetUnrotatedClimbVelocity().Z > 10.f)
+			ClimbStats::RecordProbe(EClimbProbeShape::BakedGraph, WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd, bHasWalkableSurface ? 1 : 0);
+		}
+		else
 		{
-			return true;
+			bHasWalkableSurface = DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd).bBlockingHit;
 		}
+
+		return ClimbDecision::HasReachedLedge(false, bHasWalkableSurface, GetUnrotatedClimbVelocity().Z);
 	}
 
 	return false;
@@ -416,124 +1851,303 @@ void UCustomMovementComponent::TryStartVaulting()
 	if (CanStartVaulting(VaultStartPosition, VaultLandPosition))
 	{
 		//Start Vaulting
-		SetMotionWarpTarget(FName("VaultStartPoint"), VaultStartPosition);
-		SetMotionWarpTarget(FName("VaultLandPoint"), VaultLandPosition);
-
 		StartClimbing();
-		PlayClimbMontage(ValutMontage);
+		PlayClimbAction(FName("Vault"), { VaultStartPosition, VaultLandPosition });
 	}
 }
 
 bool UCustomMovementComponent::CanStartVaulting(FVector& OutVaultStartPosition, FVector& OutVaultLandPosition)
 {
+	CLIMB_SCOPE_CYCLE_COUNTER(CanStartVaulting);
+
 	if (IsFalling()) return false;
 
 	OutVaultStartPosition = FVector::ZeroVector;
 	OutVaultLandPosition = FVector::ZeroVector;
 
-	const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-	const FVector ComponentForward = UpdatedComponent->GetForwardVector();
-	const FVector UpVector = UpdatedComponent->GetUpVector();
-	const FVector DownVector = -UpdatedComponent->GetUpVector();
+	const FVector ComponentLocation = ClimbQueryFrame.Location;
+	const FVector ComponentForward = ClimbQueryFrame.Forward;
+	const FVector UpVector = ClimbQueryFrame.Up;
+	const FVector DownVector = -ClimbQueryFrame.Up;
 
-	for (int32 i = 0; i < 5; i++)
+	//Only the first and fourth step decide the vault, skip the rest and stop as soon as the start misses
+	ClimbDecision::FVaultProbe VaultProbes[2];
+
+	for (const int32 i : { 0, 3 })
 	{
 		const FVector Start = ComponentLocation + UpVector * 100.f + ComponentForward * 80.f * (i + 1);
 		const FVector End = Start + DownVector * 100.f * (i + 1); 
 
 		FHitResult VaultTraceHit = DoLineTraceSingleByObject(Start, End);
 
-		if (i == 0 && VaultTraceHit.bBlockingHit)
-		{
-			OutVaultStartPosition = VaultTraceHit.ImpactPoint;
-		}
+		if (!VaultTraceHit.bBlockingHit) return false;
 
-		if (i == 3 && VaultTraceHit.bBlockingHit)
-		{
-			OutVaultLandPosition = VaultTraceHit.ImpactPoint;
-		}
+		ClimbDecision::FVaultProbe& VaultProbe = VaultProbes[i == 0 ? 0 : 1];
+		VaultProbe.bHit = true;
+		VaultProbe.ImpactPoint = ToClimbDecisionVector(VaultTraceHit.ImpactPoint);
 	}
 
-	if (OutVaultStartPosition != FVector::ZeroVector && OutVaultLandPosition != FVector::ZeroVector)
+	ClimbDecision::FVec3 VaultStart;
+	ClimbDecision::FVec3 VaultLand;
+	const bool bCanVault = ClimbDecision::ChooseVaultTargets(VaultProbes[0], VaultProbes[1], VaultStart, VaultLand);
+
+	OutVaultStartPosition = FromClimbDecisionVector(VaultStart);
+	OutVaultLandPosition = FromClimbDecisionVector(VaultLand);
+
+	return bCanVault;
+}
+
+bool UCustomMovementComponent::PlayClimbMontage(UAnimMontage* MontageToPlay, float StartTime)
+{
+	if (!MontageToPlay) return false;
+	if (!OwningPlayerAnimInstance) return false;
+	if (OwningPlayerAnimInstance->IsAnyMontagePlaying()) return false;
+
+	if (OwningPlayerAnimInstance->Montage_Play(MontageToPlay, 1.f, EMontagePlayReturnType::MontageLength, StartTime) > 0.f)
 	{
+		const EClimbState MontageState = GetClimbStateForMontage(MontageToPlay);
+		if (MontageState != EClimbState::None)
+		{
+			SetClimbState(MontageState);
+		}
+
 		return true;
 	}
-	else
-	{
-		return false;
-	}
+
+	return false;
+}
+
+EClimbState UCustomMovementComponent::GetClimbStateForMontage(const UAnimMontage* Montage) const
+{
+	const FClimbActionDefinition* Action = FindClimbActionForMontage(Montage);
+	return Action ? Action->State : EClimbState::None;
 }
 
-void UCustomMovementComponent::PlayClimbMontage(UAnimMontage* MontageToPlay)
+void UCustomMovementComponent::SetClimbState(EClimbState NewState)
 {
-	if (!MontageToPlay) return;
-	if (!OwningPlayerAnimInstance) return;
-	if (OwningPlayerAnimInstance->IsAnyMontagePlaying()) return;
+	if (ClimbState == NewState) return;
+
+	ClimbState = NewState;
 
-	OwningPlayerAnimInstance->Montage_Play(MontageToPlay);
+	UpdateClimbNetUpdateFrequency();
 }
 
-void UCustomMovementComponent::OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+void UCustomMovementComponent::UpdateFreeClimbState()
 {
-	if (Montage == IdleToClimbMontage || Montage == ClimbingDownLedgeMontage)
-	{
-		StartClimbing();
-		StopMovementImmediately();
-	}
+	if (!ClimbStates::IsFreeClimbing(ClimbState)) return;
+
+	const bool bMoving = !GetCurrentAcceleration().IsNearlyZero() || !Velocity.IsNearlyZero(1.f);
+	SetClimbState(bMoving ? EClimbState::Moving : EClimbState::Hanging);
+}
+
+uint8 UCustomMovementComponent::ResolveClimbProbes()
+{
+	UpdateFreeClimbState();
+
+	uint8 Probes = ClimbProbes::GetRequiredProbes(ClimbState);
 
-	if (Montage == ClimbingToTopMontage || Montage == ValutMontage)
+	//Distant and over-budget climbers keep their last surface between full frames
+	if ((Probes & ClimbProbes::SceneQueries) && !(IsFullClimbLODFrame() && AcquireClimbMaintenanceBudget()))
 	{
-		SetMovementMode(MOVE_Walking);
+		Probes &= ~ClimbProbes::SceneQueries;
 	}
+
+	return Probes;
+}
+
+void UCustomMovementComponent::OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	OnClimbActionEnded(FindClimbActionForMontage(Montage));
 }
 
 void UCustomMovementComponent::RequestHopping()
 {
+	bWantsToHop = true;
+}
+
+void UCustomMovementComponent::ExecuteHopping()
+{
+	//A hop during another transition would be dropped by PlayClimbMontage, skip its probes too
+	if (!ClimbStates::IsFreeClimbing(ClimbState)) return;
+
+	RequestFullClimbFidelity(ClimbLODTransitionHoldTime);
+
+	RefreshClimbQueryFrame();
+
+	//Acceleration is part of every saved move, so the server picks the same direction as the client
+	const FVector HopInputVector = GetCurrentAcceleration().IsNearlyZero() ? GetLastInputVector() : GetCurrentAcceleration();
+
 	const FVector UnrotatedLastInputVector = UKismetMathLibrary::Quat_UnrotateVector(
-		UpdatedComponent->GetComponentQuat(),
-		GetLastInputVector()
+		ClimbQueryFrame.Quat,
+		HopInputVector
 	);
 
-	const float DotResult = FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), FVector::UpVector);
+	if (bUseAnalogHop && TryAnalogHop(UnrotatedLastInputVector)) return;
 
-	//if you can calculate by input value when moving through climb, you can use that axis for calculate which direction you want to hop, but in this case, just up and down is enough.
-	/*if (DotResult > -0.5f && DotResult < 0.5f)
+	switch (ClimbDecision::SelectHopDirection(ToClimbDecisionVector(UnrotatedLastInputVector)))
 	{
-		Debug::Print(TEXT("Hop right or left!"));
-
+	case ClimbDecision::EHopDirection::Up:
+		HandleHopUp();
+		break;
+	case ClimbDecision::EHopDirection::Down:
+		HandleHopDown();
+		break;
+	case ClimbDecision::EHopDirection::Right:
+		HandleHopRight();
+		break;
+	case ClimbDecision::EHopDirection::Left:
+		HandleHopLeft();
+		break;
+	case ClimbDecision::EHopDirection::None:
+		break;
 	}
-	else if (DotResult >= 0.5f)
+}
+
+bool UCustomMovementComponent::TryAnalogHop(const FVector& UnrotatedInput)
+{
+	CLIMB_SCOPE_CYCLE_COUNTER(TryAnalogHop);
+
+	const ClimbDecision::EHopOctant Octant = ClimbDecision::SelectHopOctant(ToClimbDecisionVector(UnrotatedInput));
+	if (Octant == ClimbDecision::EHopOctant::None) return false;
+
+	const FVector HopDirection = (ClimbQueryFrame.Right * UnrotatedInput.Y + ClimbQueryFrame.Up * UnrotatedInput.Z).GetSafeNormal();
+
+	//Samples sit a little in front of the climbed plane so the closest point query always reports a surface normal
+	const float SurfaceDepth = FVector::DotProduct(CurrentClimbableSurfaceLocation - ClimbQueryFrame.Location, ClimbQueryFrame.Forward);
+	const float SampleDepth = SurfaceDepth - 10.f;
+	const FVector IdealTarget = ClimbQueryFrame.Location + ClimbQueryFrame.Forward * SurfaceDepth + GetAnalogHopOffset(HopDirection);
+
+	GatherAnalogHopCandidates(HopDirection, IdealTarget, SampleDepth);
+
+	FClimbHopScoring Scoring;
+	Scoring.IdealTarget = IdealTarget - ClimbQueryFrame.Location;
+	Scoring.SurfaceNormal = CurrentClimbableSurfaceNormal;
+	Scoring.Reach = AnalogHopReach;
+	Scoring.MaxGap = AnalogHopMaxGap;
+
+	const int32 BestIndex = AnalogHopCandidates.FindBest(Scoring);
+	if (BestIndex == INDEX_NONE) return false;
+
+	const FVector HopTargetPoint = AnalogHopCandidates.GetPosition(BestIndex);
+
+	//Like CheckCanHopUp, the wall has to go on above an upward target or the hop lands on a strip just below a ledge
+	if (Octant == ClimbDecision::EHopOctant::UpRight || Octant == ClimbDecision::EHopOctant::Up || Octant == ClimbDecision::EHopOctant::UpLeft)
 	{
-		Debug::Print(TEXT("Hop up!"));
+		const FVector TargetOffset = HopTargetPoint - ClimbQueryFrame.Location;
+		const FVector SafetyStart = ClimbQueryFrame.Location +
+			ClimbQueryFrame.Right * FVector::DotProduct(TargetOffset, ClimbQueryFrame.Right) +
+			ClimbQueryFrame.Up * (FVector::DotProduct(TargetOffset, ClimbQueryFrame.Up) + 160.f);
+
+		if (!DoClimbProbe(SafetyStart, SafetyStart + ClimbQueryFrame.Forward * 100.f).bBlockingHit) return false;
 	}
-	else if (DotResult <= -0.5f)
+
+	//Diagonal actions are optional in the action set, without one the closest cardinal hop plays and motion warping bends it
+	static const FName OctantActionNames[] =
 	{
-		Debug::Print(TEXT("Hop down!!"));
-	}
-	else
+		FName("HopRight"), FName("HopUpRight"), FName("HopUp"), FName("HopUpLeft"),
+		FName("HopLeft"), FName("HopDownLeft"), FName("HopDown"), FName("HopDownRight")
+	};
+	static const FName CardinalActionNames[] = { FName("HopUp"), FName("HopDown"), FName("HopRight"), FName("HopLeft") };
+
+	FName ActionName = OctantActionNames[(uint8)Octant];
+	if (!ClimbActionIndexByName.Contains(ActionName))
 	{
-		Debug::Print(TEXT("Hop left!!"));
-	}*/
+		ActionName = CardinalActionNames[(uint8)ClimbDecision::SelectHopDirection(ToClimbDecisionVector(UnrotatedInput))];
+	}
+
+	PlayClimbAction(ActionName, { HopTargetPoint });
+	return true;
+}
+
+FVector UCustomMovementComponent::GetAnalogHopOffset(const FVector& HopDirection) const
+{
+	//Up and down keep the cardinal hop lengths, sideways is AnalogHopDistance
+	const float EyeHeight = CharacterOwner->BaseEyeHeight;
+	const float RightAmount = FVector::DotProduct(HopDirection, ClimbQueryFrame.Right);
+	const float UpAmount = FVector::DotProduct(HopDirection, ClimbQueryFrame.Up);
+	const float VerticalDistance = GetCardinalHopDistance(UpAmount >= 0.f ? EClimbHopDirection::Up : EClimbHopDirection::Down, EyeHeight);
+
+	return ClimbQueryFrame.Right * (RightAmount * AnalogHopDistance) + ClimbQueryFrame.Up * (UpAmount * VerticalDistance);
+}
+
+void UCustomMovementComponent::GatherAnalogHopCandidates(const FVector& HopDirection, const FVector& IdealTarget, float SampleDepth)
+{
+	AnalogHopCandidates.Reset(ClimbQueryFrame.Location);
+
+	const FVector OverlapCenter = IdealTarget;
+	const float OverlapRadius = AnalogHopReach + AnalogHopMaxGap;
+
+	const uint64 QueryStartCycles = FPlatformTime::Cycles64();
+
+	AnalogHopOverlaps.Reset();
+	GetWorld()->OverlapMultiByObjectType(
+		AnalogHopOverlaps,
+		OverlapCenter,
+		FQuat::Identity,
+		ClimbObjectQueryParams,
+		FCollisionShape::MakeSphere(OverlapRadius),
+		ClimbQueryParams
+	);
+
+	ChargeClimbQueryCycles(QueryStartCycles);
 
-	if (DotResult <= -0.9f)
+	NumClimbQueriesIssued++;
+	ClimbStats::RecordProbe(EClimbProbeShape::Overlap, OverlapCenter, OverlapCenter, AnalogHopOverlaps.Num());
+
+	TArray<UPrimitiveComponent*, TInlineAllocator<8>> FanPrimitives;
+	for (const FOverlapResult& Overlap : AnalogHopOverlaps)
 	{
-		HandleHopDown();
+		if (UPrimitiveComponent* Primitive = Overlap.GetComponent()) FanPrimitives.AddUnique(Primitive);
 	}
-	else if (DotResult >= 0.9f)
+
+	if (FanPrimitives.IsEmpty()) return;
+
+	//Overlap order is arbitrary, keep the primitives nearest the ideal target so the wall the hop aims at is never capped away
+	constexpr int32 MaxFanPrimitives = 4;
+	if (FanPrimitives.Num() > MaxFanPrimitives)
 	{
-		HandleHopUp();
+		FanPrimitives.Sort([&IdealTarget](const UPrimitiveComponent& A, const UPrimitiveComponent& B)
+		{
+			return A.Bounds.ComputeSquaredDistanceFromBoxToPoint(IdealTarget) < B.Bounds.ComputeSquaredDistanceFromBoxToPoint(IdealTarget);
+		});
+		FanPrimitives.SetNum(MaxFanPrimitives);
 	}
-	else
+
+	//The climbed primitive is answered from its cached planes where a sample faces one of them
+	const UPrimitiveComponent* AnalyticPrimitive = IsAnalyticClimbSurfaceUsable() ? AnalyticClimbSurface.GetPrimitive() : nullptr;
+
+	//Five angles across the fan at three lengths, every sample is resolved against the overlapped primitives without another scene query
+	constexpr int32 NumFanAngles = 5;
+	static const float FanLengthScales[] = { 0.6f, 1.f, 1.4f };
+
+	for (int32 AngleIndex = 0; AngleIndex < NumFanAngles; AngleIndex++)
 	{
-		const float DotHorizontalResult = FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), FVector::RightVector);
+		const float FanAngle = FMath::Lerp(-AnalogHopFanAngle, AnalogHopFanAngle, AngleIndex / (float)(NumFanAngles - 1));
+		const FVector SampleDirection = HopDirection.RotateAngleAxis(FanAngle, ClimbQueryFrame.Forward);
 
-		if (DotHorizontalResult >= 0.9f)
+		for (const float LengthScale : FanLengthScales)
 		{
-			HandleHopRight();
-		}
-		else if (DotHorizontalResult <= 0.9f)
-		{
-			HandleHopLeft();
+			const FVector Sample = ClimbQueryFrame.Location + ClimbQueryFrame.Forward * SampleDepth + GetAnalogHopOffset(SampleDirection) * LengthScale;
+
+			for (UPrimitiveComponent* Primitive : FanPrimitives)
+			{
+				FVector SurfaceLocation;
+				FVector SurfaceNormal;
+				if (Primitive == AnalyticPrimitive && AnalyticClimbSurface.FindSurface(Sample, 0.f, SurfaceLocation, SurfaceNormal))
+				{
+					ClimbStats::RecordProbe(EClimbProbeShape::Analytic, Sample, SurfaceLocation, 1);
+					AnalogHopCandidates.Add(SurfaceLocation, SurfaceNormal, FVector::Dist(Sample, SurfaceLocation));
+					continue;
+				}
+
+				FVector ClosestPoint;
+				const float Gap = Primitive->GetClosestPointOnCollision(Sample, ClosestPoint);
+
+				//Zero is a sample inside the collision, negative a primitive without usable collision
+				if (Gap <= 0.f) continue;
+
+				AnalogHopCandidates.Add(ClosestPoint, (Sample - ClosestPoint) / Gap, Gap);
+			}
 		}
 	}
 }
@@ -552,16 +2166,30 @@ void UCustomMovementComponent::SetMotionWarpTarget(const FName& InWarpTargetName
 void UCustomMovementComponent::HandleHopUp()
 {
 	FVector HopUpTargetPoint;
-	if (CheckCanHopUp(HopUpTargetPoint))
+	if (ResolveHopTarget(EClimbHopDirection::Up, HopUpTargetPoint))
 	{
-		SetMotionWarpTarget(FName("HopUpTargetPoint"), HopUpTargetPoint);
+		PlayClimbAction(FName("HopUp"), { HopUpTargetPoint });
+	}
+}
 
-		PlayClimbMontage(HopUpMontage);
+float UCustomMovementComponent::GetCardinalHopDistance(EClimbHopDirection Direction, float EyeHeight)
+{
+	//Where the eye height and side traces below land
+	switch (Direction)
+	{
+	case EClimbHopDirection::Up:
+		return FMath::Max(EyeHeight - 10.f, 0.f);
+	case EClimbHopDirection::Down:
+		return FMath::Max(300.f - EyeHeight, 0.f);
+	default:
+		return 110.f;
 	}
 }
 
 bool UCustomMovementComponent::CheckCanHopUp(FVector& OutHopUpTargetPosition)
 {
+	CLIMB_SCOPE_CYCLE_COUNTER(CheckCanHopUp);
+
 	FHitResult HopUpHit = TraceFromEyeHeight(100.f, -10.f);
 	FHitResult SaftyLedgeHit = TraceFromEyeHeight(100.f, 150.f);
 
@@ -576,16 +2204,16 @@ bool UCustomMovementComponent::CheckCanHopUp(FVector& OutHopUpTargetPosition)
 void UCustomMovementComponent::HandleHopDown()
 {
 	FVector HopDownTargetPoint;
-	if (CheckCanHopDown(HopDownTargetPoint))
+	if (ResolveHopTarget(EClimbHopDirection::Down, HopDownTargetPoint))
 	{
-		SetMotionWarpTarget(FName("HopDownTargetPoint"), HopDownTargetPoint);
-
-		PlayClimbMontage(HopDownMontage);
+		PlayClimbAction(FName("HopDown"), { HopDownTargetPoint });
 	}
 }
 
 bool UCustomMovementComponent::CheckCanHopDown(FVector& OutHopDownTargetPosition)
 {
+	CLIMB_SCOPE_CYCLE_COUNTER(CheckCanHopDown);
+
 	FHitResult HopDownHit = TraceFromEyeHeight(100.f, -300.f);
 
 	if (HopDownHit.bBlockingHit)
@@ -600,16 +2228,16 @@ bool UCustomMovementComponent::CheckCanHopDown(FVector& OutHopDownTargetPosition
 void UCustomMovementComponent::HandleHopRight()
 {
 	FVector HopRightTargetPoint;
-	if (CheckCanHopRight(HopRightTargetPoint))
+	if (ResolveHopTarget(EClimbHopDirection::Right, HopRightTargetPoint))
 	{
-		SetMotionWarpTarget(FName("HopRightTargetPoint"), HopRightTargetPoint);
-
-		PlayClimbMontage(HopRightMontage);
+		PlayClimbAction(FName("HopRight"), { HopRightTargetPoint });
 	}
 }
 
 bool UCustomMovementComponent::CheckCanHopRight(FVector& OutHopRightTargetPosition)
 {
+	CLIMB_SCOPE_CYCLE_COUNTER(CheckCanHopRight);
+
 	FHitResult HopRightHit = TraceFromRight(100.f, 110.f);
 
 	if (HopRightHit.bBlockingHit)
@@ -624,16 +2252,16 @@ bool UCustomMovementComponent::CheckCanHopRight(FVector& OutHopRightTargetPositi
 void UCustomMovementComponent::HandleHopLeft()
 {
 	FVector HopLeftTargetPoint;
-	if (CheckCanHopLeft(HopLeftTargetPoint))
+	if (ResolveHopTarget(EClimbHopDirection::Left, HopLeftTargetPoint))
 	{
-		SetMotionWarpTarget(FName("HopLeftTargetPoint"), HopLeftTargetPoint);
-
-		PlayClimbMontage(HopLeftMontage);
+		PlayClimbAction(FName("HopLeft"), { HopLeftTargetPoint });
 	}
 }
 
 bool UCustomMovementComponent::CheckCanHopLeft(FVector& OutHopLeftTargetPosition)
 {
+	CLIMB_SCOPE_CYCLE_COUNTER(CheckCanHopLeft);
+
 	FHitResult HopLeftHit = TraceFromLeft(100.f, 110.f);
 
 	if (HopLeftHit.bBlockingHit)
@@ -646,6 +2274,124 @@ bool UCustomMovementComponent::CheckCanHopLeft(FVector& OutHopLeftTargetPosition
 }
 #pragma endregion
 
+#pragma region ClimbReplication
+
+void UCustomMovementComponent::UpdateClimbNetUpdateFrequency()
+{
+	if (!bUseClimbNetUpdateFrequency || !CharacterOwner || !CharacterOwner->HasAuthority()) return;
+
+	float NewFrequency = DefaultNetUpdateFrequency;
+
+	switch (ClimbState)
+	{
+	case EClimbState::Hanging:
+		NewFrequency = ClimbIdleNetUpdateFrequency;
+		break;
+	case EClimbState::Moving:
+		NewFrequency = ClimbMovingNetUpdateFrequency;
+		break;
+	case EClimbState::None:
+		break;
+	default:
+		NewFrequency = ClimbTransitionNetUpdateFrequency;
+		break;
+	}
+
+	const float OldFrequency = CharacterOwner->NetUpdateFrequency;
+	if (FMath::IsNearlyEqual(OldFrequency, NewFrequency)) return;
+
+	CharacterOwner->NetUpdateFrequency = NewFrequency;
+
+	if (UClimbReplicationGraph* ReplicationGraph = UClimbReplicationGraph::Get(GetWorld()))
+	{
+		ReplicationGraph->OnNetUpdateFrequencyChanged(CharacterOwner);
+	}
+
+	//A transition should go out now rather than when the idle period runs out
+	if (NewFrequency > OldFrequency)
+	{
+		CharacterOwner->ForceNetUpdate();
+	}
+}
+
+void UCustomMovementComponent::UpdateReplicatedClimbSurface()
+{
+	if (!bReplicateClimbSurface || !IsClimbing() || !CharacterOwner->HasAuthority()) return;
+
+	//Sub-quantization jitter would otherwise mark the fields dirty every frame
+	if (!ReplicatedClimbSurface.Location.Equals(CurrentClimbableSurfaceLocation, 1.f))
+	{
+		ReplicatedClimbSurface.Location = CurrentClimbableSurfaceLocation;
+	}
+
+	if (FVector::DotProduct(ReplicatedClimbSurface.Normal, CurrentClimbableSurfaceNormal) < 0.9995f)
+	{
+		ReplicatedClimbSurface.Normal = CurrentClimbableSurfaceNormal;
+	}
+}
+
+void UCustomMovementComponent::OnRep_ClimbSurface()
+{
+	if (!CharacterOwner || CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy) return;
+
+	CurrentClimbableSurfaceLocation = ReplicatedClimbSurface.Location;
+	CurrentClimbableSurfaceNormal = ReplicatedClimbSurface.Normal;
+}
+
+#pragma endregion
+
+#pragma region ClimbLOD
+
+void UCustomMovementComponent::UpdateClimbLOD()
+{
+	ClimbLOD = 0;
+
+	//Players always climb at full fidelity, so do climbers nobody could be watching closely enough to tell
+	if (!IsClimbing() || !CharacterOwner || CharacterOwner->IsPlayerControlled()) return;
+
+	float ClosestViewDistanceSquared = MAX_flt;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		ClosestViewDistanceSquared = FMath::Min(ClosestViewDistanceSquared, FVector::DistSquared(ViewLocation, UpdatedComponent->GetComponentLocation()));
+	}
+
+	if (ClosestViewDistanceSquared >= FMath::Square(ClimbLODMinimalDistance))
+	{
+		ClimbLOD = 2;
+	}
+	else if (ClosestViewDistanceSquared >= FMath::Square(ClimbLODReducedDistance))
+	{
+		ClimbLOD = 1;
+	}
+}
+
+bool UCustomMovementComponent::IsFullClimbLODFrame() const
+{
+	if (!bUseClimbLOD || ClimbLOD == 0) return true;
+
+	//Transitions need exact surfaces, whatever the distance
+	if (HasAnimRootMotion() || bWantsToStartClimbing || bWantsToStopClimbing || bWantsToHop) return true;
+	if (GetWorld()->GetTimeSeconds() < ClimbLODFullFidelityEndTime) return true;
+
+	const int32 FrameInterval = FMath::Max(ClimbLOD == 1 ? ClimbLODReducedFrameInterval : ClimbLODMinimalFrameInterval, 1);
+
+	//Stagger climbers so their full frames spread over the interval
+	return (GFrameCounter + GetUniqueID()) % FrameInterval == 0;
+}
+
+void UCustomMovementComponent::RequestFullClimbFidelity(float Duration)
+{
+	ClimbLODFullFidelityEndTime = FMath::Max(ClimbLODFullFidelityEndTime, GetWorld()->GetTimeSeconds() + Duration);
+}
+#pragma endregion
+
 bool UCustomMovementComponent::IsClimbing() const
 {
 	return MovementMode == MOVE_Custom && CustomMovementMode == ECustomMovementMode::MOVE_Climb;
@@ -659,43 +2405,41 @@ FVector UCustomMovementComponent::GetUnrotatedClimbVelocity() const
 //Trace for climbalbe surfaces, return "true" if it is climbable, return false otherwise;
 bool UCustomMovementComponent::TraceClimbableSurfaces()
 {
-	const FVector StartOffset = UpdatedComponent->GetForwardVector() * 30.f;
-	const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;
-	const FVector End = Start + UpdatedComponent->GetForwardVector();
-	ClimbableSurfacesTracedResults = DoCapsuleTraceMultiByObject(Start, End);
+	CLIMB_SCOPE_CYCLE_COUNTER(TraceClimbableSurfaces);
+
+	const FVector StartOffset = ClimbQueryFrame.Forward * 30.f;
+	const FVector Start = ClimbQueryFrame.Location + StartOffset;
+	const FVector End = Start + ClimbQueryFrame.Forward;
 
-	return !ClimbableSurfacesTracedResults.IsEmpty();
+	return DoCapsuleTraceMultiByObject(Start, End, ClimbableSurfaceHits);
 }
 
 FHitResult UCustomMovementComponent::TraceFromEyeHeight(float TraceDistance, float TraceStartOffset, bool bShowDebugShape, bool bDrawPersistantShape)
 {
-	const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-	const FVector EyeHeightOffset = UpdatedComponent->GetUpVector() * (CharacterOwner->BaseEyeHeight + TraceStartOffset);
+	const FVector EyeHeightOffset = ClimbQueryFrame.Up * (CharacterOwner->BaseEyeHeight + TraceStartOffset);
 
-	const FVector Start = ComponentLocation + EyeHeightOffset;
-	const FVector End = Start + UpdatedComponent->GetForwardVector() * TraceDistance;
+	const FVector Start = ClimbQueryFrame.Location + EyeHeightOffset;
+	const FVector End = Start + ClimbQueryFrame.Forward * TraceDistance;
 
-	return DoLineTraceSingleByObject(Start, End, bShowDebugShape, bDrawPersistantShape);
+	return DoClimbProbe(Start, End, bShowDebugShape, bDrawPersistantShape);
 }
 
 FHitResult UCustomMovementComponent::TraceFromRight(float TraceDistance, float TraceStartOffset, bool bShowDebugShape, bool bDrawPersistantShape)
 {
-	const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-	const FVector HorizontalOffset = UpdatedComponent->GetRightVector() * TraceStartOffset;
+	const FVector HorizontalOffset = ClimbQueryFrame.Right * TraceStartOffset;
 
-	const FVector Start = ComponentLocation + HorizontalOffset;
-	const FVector End = Start + UpdatedComponent->GetForwardVector() * TraceDistance;
+	const FVector Start = ClimbQueryFrame.Location + HorizontalOffset;
+	const FVector End = Start + ClimbQueryFrame.Forward * TraceDistance;
 
-	return DoLineTraceSingleByObject(Start, End, bShowDebugShape, bDrawPersistantShape);
+	return DoClimbProbe(Start, End, bShowDebugShape, bDrawPersistantShape);
 }
 
 FHitResult UCustomMovementComponent::TraceFromLeft(float TraceDistance, float TraceStartOffset, bool bShowDebugShape, bool bDrawPersistantShape)
 {
-	const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-	const FVector HorizontalOffset = -UpdatedComponent->GetRightVector() * TraceStartOffset;
+	const FVector HorizontalOffset = -ClimbQueryFrame.Right * TraceStartOffset;
 
-	const FVector Start = ComponentLocation + HorizontalOffset;
-	const FVector End = Start + UpdatedComponent->GetForwardVector() * TraceDistance;
+	const FVector Start = ClimbQueryFrame.Location + HorizontalOffset;
+	const FVector End = Start + ClimbQueryFrame.Forward * TraceDistance;
 
-	return DoLineTraceSingleByObject(Start, End, bShowDebugShape, bDrawPersistantShape);
+	return DoClimbProbe(Start, End, bShowDebugShape, bDrawPersistantShape);
 }
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/ClimbActionSet.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#include "UObject/ObjectSaveContext.h"
+#include "Animation/AnimMontage.h"
+
+void UClimbActionSet::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	for (FClimbActionDefinition& Action : Actions)
+	{
+		Action.ServerRootMotion = FClimbRootMotionTrack();
+
+		if (const UAnimMontage* Montage = Action.Montage.LoadSynchronous())
+		{
+			Action.ServerRootMotion.Bake(*Montage, ServerRootMotionSampleRate);
+		}
+	}
+}
+
+EDataValidationResult UClimbActionSet::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	if (Actions.Num() > MAX_uint8)
+	{
+		Context.AddError(FText::Format(NSLOCTEXT("ClimbActionSet", "TooManyActions", "{0} climb actions, the action id is a single byte so at most 255 are supported."), Actions.Num()));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	TSet<FName> ActionNames;
+	for (const FClimbActionDefinition& Action : Actions)
+	{
+		bool bAlreadyInSet = false;
+		ActionNames.Add(Action.ActionName, &bAlreadyInSet);
+
+		if (Action.ActionName.IsNone() || bAlreadyInSet)
+		{
+			Context.AddError(FText::Format(NSLOCTEXT("ClimbActionSet", "BadActionName", "Climb action name '{0}' is empty or used twice."), FText::FromName(Action.ActionName)));
+			Result = EDataValidationResult::Invalid;
+		}
+
+		if (Action.Montage.IsNull())
+		{
+			Context.AddError(FText::Format(NSLOCTEXT("ClimbActionSet", "MissingMontage", "Climb action '{0}' has no montage."), FText::FromName(Action.ActionName)));
+			Result = EDataValidationResult::Invalid;
+		}
+	}
+
+	return Result;
+}
+#endif
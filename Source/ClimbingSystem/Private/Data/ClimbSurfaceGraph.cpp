@@ -0,0 +1,244 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/ClimbSurfaceGraph.h"
+
+template<typename FunctionType>
+void UClimbSurfaceGraph::ForEachNodeInRadius(const FVector& Location, float Radius, FunctionType Function) const
+{
+	const FIntVector MinCell = GetCellCoord(Location - FVector(Radius));
+	const FIntVector MaxCell = GetCellCoord(Location + FVector(Radius));
+	const float RadiusSquared = Radius * Radius;
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const FClimbGraphCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (!Cell) continue;
+
+				for (int32 NodeIndex = Cell->FirstNode; NodeIndex < Cell->FirstNode + Cell->NumNodes; NodeIndex++)
+				{
+					if (FVector::DistSquared(Nodes[NodeIndex].Location, Location) <= RadiusSquared)
+					{
+						Function(NodeIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool UClimbSurfaceGraph::FindNodeAlongRay(const FVector& Start, const FVector& Direction, float MaxDistance, float LateralTolerance, EClimbGraphNodeType Type, int32& OutNodeIndex) const
+{
+	OutNodeIndex = INDEX_NONE;
+	float BestAlong = MAX_flt;
+
+	const FVector RayCenter = Start + Direction * (MaxDistance * 0.5f);
+	const float SearchRadius = MaxDistance * 0.5f + LateralTolerance;
+
+	ForEachNodeInRadius(RayCenter, SearchRadius, [&](int32 NodeIndex)
+	{
+		const FClimbGraphNode& Node = Nodes[NodeIndex];
+		if (Node.Type != Type) return;
+
+		//Only surfaces facing the ray would have blocked a trace
+		if (FVector::DotProduct(FVector(Node.Normal), Direction) >= 0.f) return;
+
+		const FVector ToNode = Node.Location - Start;
+		const float Along = FVector::DotProduct(ToNode, Direction);
+		if (Along < 0.f || Along > MaxDistance) return;
+
+		const float LateralSquared = (ToNode - Direction * Along).SizeSquared();
+		if (LateralSquared > LateralTolerance * LateralTolerance) return;
+
+		if (Along < BestAlong)
+		{
+			BestAlong = Along;
+			OutNodeIndex = NodeIndex;
+		}
+	});
+
+	return OutNodeIndex != INDEX_NONE;
+}
+
+bool UClimbSurfaceGraph::FindNearestNode(const FVector& Location, float Radius, EClimbGraphNodeType Type, int32& OutNodeIndex) const
+{
+	OutNodeIndex = INDEX_NONE;
+	float BestDistanceSquared = MAX_flt;
+
+	ForEachNodeInRadius(Location, Radius, [&](int32 NodeIndex)
+	{
+		if (Nodes[NodeIndex].Type != Type) return;
+
+		const float DistanceSquared = FVector::DistSquared(Nodes[NodeIndex].Location, Location);
+		if (DistanceSquared < BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			OutNodeIndex = NodeIndex;
+		}
+	});
+
+	return OutNodeIndex != INDEX_NONE;
+}
+
+bool UClimbSurfaceGraph::FindHopTarget(const FVector& FromLocation, float SnapRadius, EClimbHopDirection Direction, int32& OutNodeIndex) const
+{
+	OutNodeIndex = INDEX_NONE;
+
+	int32 FromNodeIndex;
+	if (!FindNearestNode(FromLocation, SnapRadius, EClimbGraphNodeType::GrabPoint, FromNodeIndex)) return false;
+
+	const FClimbGraphNode& FromNode = Nodes[FromNodeIndex];
+	for (int32 EdgeIndex = FromNode.FirstEdge; EdgeIndex < FromNode.FirstEdge + FromNode.NumEdges; EdgeIndex++)
+	{
+		if (Edges[EdgeIndex].Direction == Direction)
+		{
+			OutNodeIndex = Edges[EdgeIndex].TargetNode;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UClimbSurfaceGraph::HasCoverage(const FVector& Location, float Radius) const
+{
+	const FIntVector MinCell = GetCellCoord(Location - FVector(Radius));
+	const FIntVector MaxCell = GetCellCoord(Location + FVector(Radius));
+	const float RadiusSquared = Radius * Radius;
+
+	//Any single node answers it, stop at the first one instead of walking the rest of the cells
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const FClimbGraphCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (!Cell) continue;
+
+				for (int32 NodeIndex = Cell->FirstNode; NodeIndex < Cell->FirstNode + Cell->NumNodes; NodeIndex++)
+				{
+					if (FVector::DistSquared(Nodes[NodeIndex].Location, Location) <= RadiusSquared) return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+#if WITH_EDITOR
+void UClimbSurfaceGraph::Build(TArray<FClimbGraphNode>&& InNodes, float InCellSize, const FClimbGraphHopSettings& HopSettings)
+{
+	CellSize = FMath::Max(InCellSize, 1.f);
+	Nodes = MoveTemp(InNodes);
+	Edges.Reset();
+	Cells.Reset();
+
+	Nodes.Sort([this](const FClimbGraphNode& A, const FClimbGraphNode& B)
+	{
+		const FIntVector CellA = GetCellCoord(A.Location);
+		const FIntVector CellB = GetCellCoord(B.Location);
+
+		if (CellA.X != CellB.X) return CellA.X < CellB.X;
+		if (CellA.Y != CellB.Y) return CellA.Y < CellB.Y;
+		return CellA.Z < CellB.Z;
+	});
+
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		FClimbGraphCell& Cell = Cells.FindOrAdd(GetCellCoord(Nodes[NodeIndex].Location));
+		if (Cell.NumNodes == 0)
+		{
+			Cell.FirstNode = NodeIndex;
+		}
+		Cell.NumNodes++;
+	}
+
+	float MaxHopDistance = 0.f;
+	for (const float HopDistance : HopSettings.Distances)
+	{
+		MaxHopDistance = FMath::Max(MaxHopDistance, HopDistance);
+	}
+
+	const float HopSearchRadius = MaxHopDistance + HopSettings.Tolerance * 2.f;
+
+	//One hop edge per direction, to the grab point on the same facing closest to where the authored hop lands
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		FClimbGraphNode& Node = Nodes[NodeIndex];
+		Node.FirstEdge = Edges.Num();
+		Node.NumEdges = 0;
+
+		if (Node.Type != EClimbGraphNodeType::GrabPoint) continue;
+
+		const FVector WallNormal = FVector(Node.Normal);
+		const FVector WallUp = FVector::VectorPlaneProject(FVector::UpVector, WallNormal).GetSafeNormal();
+		const FVector WallRight = FVector::CrossProduct(WallUp, -WallNormal);
+		if (WallUp.IsNearlyZero()) continue;
+
+		const FVector DirectionAxes[] = { WallUp, -WallUp, WallRight, -WallRight };
+
+		int32 BestTargets[UE_ARRAY_COUNT(DirectionAxes)];
+		float BestScores[UE_ARRAY_COUNT(DirectionAxes)];
+		for (int32 DirectionIndex = 0; DirectionIndex < UE_ARRAY_COUNT(DirectionAxes); DirectionIndex++)
+		{
+			BestTargets[DirectionIndex] = INDEX_NONE;
+			BestScores[DirectionIndex] = MAX_flt;
+		}
+
+		ForEachNodeInRadius(Node.Location, HopSearchRadius, [&](int32 OtherIndex)
+		{
+			const FClimbGraphNode& Other = Nodes[OtherIndex];
+			if (OtherIndex == NodeIndex || Other.Type != EClimbGraphNodeType::GrabPoint) return;
+			if (FVector3f::DotProduct(Other.Normal, Node.Normal) < 0.7f) return;
+
+			const FVector Offset = Other.Location - Node.Location;
+
+			for (int32 DirectionIndex = 0; DirectionIndex < UE_ARRAY_COUNT(DirectionAxes); DirectionIndex++)
+			{
+				const float Along = FVector::DotProduct(Offset, DirectionAxes[DirectionIndex]);
+				const float LengthError = FMath::Abs(Along - HopSettings.Distances[DirectionIndex]);
+				const float Lateral = (Offset - DirectionAxes[DirectionIndex] * Along).Size();
+				if (LengthError > HopSettings.Tolerance || Lateral > HopSettings.Tolerance) continue;
+
+				//Closest to the authored landing, straight hops first
+				const float Score = LengthError + Lateral * 2.f;
+				if (Score >= BestScores[DirectionIndex]) continue;
+
+				if ((EClimbHopDirection)DirectionIndex == EClimbHopDirection::Up && !HasGrabPointAbove(Other, WallUp, HopSettings)) continue;
+
+				BestScores[DirectionIndex] = Score;
+				BestTargets[DirectionIndex] = OtherIndex;
+			}
+		});
+
+		for (int32 DirectionIndex = 0; DirectionIndex < UE_ARRAY_COUNT(DirectionAxes); DirectionIndex++)
+		{
+			if (BestTargets[DirectionIndex] == INDEX_NONE) continue;
+
+			FClimbGraphEdge& Edge = Edges.AddDefaulted_GetRef();
+			Edge.TargetNode = BestTargets[DirectionIndex];
+			Edge.Direction = (EClimbHopDirection)DirectionIndex;
+			Node.NumEdges++;
+		}
+	}
+}
+
+bool UClimbSurfaceGraph::HasGrabPointAbove(const FClimbGraphNode& Node, const FVector& WallUp, const FClimbGraphHopSettings& HopSettings) const
+{
+	bool bFound = false;
+
+	ForEachNodeInRadius(Node.Location + WallUp * HopSettings.UpSafetyHeight, HopSettings.UpSafetyRadius, [&](int32 OtherIndex)
+	{
+		const FClimbGraphNode& Other = Nodes[OtherIndex];
+		bFound |= Other.Type == EClimbGraphNodeType::GrabPoint && FVector3f::DotProduct(Other.Normal, Node.Normal) >= 0.7f;
+	});
+
+	return bFound;
+}
+#endif
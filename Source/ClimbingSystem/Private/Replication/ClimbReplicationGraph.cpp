@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Replication/ClimbReplicationGraph.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+
+void UClimbReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	GridNode->CellSize = GridCellSize;
+}
+
+void UClimbReplicationGraph::OnNetUpdateFrequencyChanged(AActor* Actor)
+{
+	FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor);
+	if (!GlobalInfo) return;
+
+	const uint32 ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(Actor->NetUpdateFrequency);
+	GlobalInfo->Settings.ReplicationPeriodFrame = ReplicationPeriodFrame;
+
+	//Connections copy the period into their own actor info when the actor is first seen, so push it there as well
+	for (UNetReplicationGraphConnection* Connection : Connections)
+	{
+		if (FConnectionReplicationActorInfo* ConnectionInfo = Connection ? Connection->ActorInfoMap.Find(Actor) : nullptr)
+		{
+			ConnectionInfo->ReplicationPeriodFrame = ReplicationPeriodFrame;
+		}
+	}
+}
+
+UClimbReplicationGraph* UClimbReplicationGraph::Get(const UWorld* World)
+{
+	const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	return NetDriver ? Cast<UClimbReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+}
@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ClimbBatchSubsystem.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+
+int32 UClimbBatchSubsystem::RegisterClimber(UCustomMovementComponent* Climber)
+{
+	const int32 BatchIndex = Climbers.Add(Climber);
+
+	Locations.AddZeroed();
+	Rotations.Add(FQuat::Identity);
+	Velocities.AddZeroed();
+	Accelerations.AddZeroed();
+	SurfaceLocations.AddZeroed();
+	SurfaceNormals.AddZeroed();
+	MaxSpeeds.AddZeroed();
+	CapsuleRadii.AddZeroed();
+	BrakingDecelerations.AddZeroed();
+	MoveDeltas.AddZeroed();
+	ActiveFlags.AddZeroed();
+
+	return BatchIndex;
+}
+
+void UClimbBatchSubsystem::UnregisterClimber(UCustomMovementComponent* Climber)
+{
+	const int32 BatchIndex = Climbers.Find(Climber);
+	if (BatchIndex != INDEX_NONE)
+	{
+		RemoveClimberAt(BatchIndex);
+	}
+}
+
+void UClimbBatchSubsystem::RemoveClimberAt(int32 BatchIndex)
+{
+	Climbers.RemoveAtSwap(BatchIndex);
+	Locations.RemoveAtSwap(BatchIndex);
+	Rotations.RemoveAtSwap(BatchIndex);
+	Velocities.RemoveAtSwap(BatchIndex);
+	Accelerations.RemoveAtSwap(BatchIndex);
+	SurfaceLocations.RemoveAtSwap(BatchIndex);
+	SurfaceNormals.RemoveAtSwap(BatchIndex);
+	MaxSpeeds.RemoveAtSwap(BatchIndex);
+	CapsuleRadii.RemoveAtSwap(BatchIndex);
+	BrakingDecelerations.RemoveAtSwap(BatchIndex);
+	MoveDeltas.RemoveAtSwap(BatchIndex);
+	ActiveFlags.RemoveAtSwap(BatchIndex);
+
+	//The climber swapped into this slot needs to know where it lives now
+	if (Climbers.IsValidIndex(BatchIndex) && Climbers[BatchIndex])
+	{
+		Climbers[BatchIndex]->ClimbBatchIndex = BatchIndex;
+	}
+}
+
+void UClimbBatchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const uint64 TickStartCycles = FPlatformTime::Cycles64();
+
+	if (!Climbers.IsEmpty() && DeltaTime >= UCharacterMovementComponent::MIN_TICK_TIME)
+	{
+		GatherClimbers(DeltaTime);
+		IntegrateClimbers(DeltaTime);
+		ApplyClimbers(DeltaTime);
+	}
+
+	LastTickCycles = FPlatformTime::Cycles64() - TickStartCycles;
+}
+
+void UClimbBatchSubsystem::GatherClimbers(float DeltaTime)
+{
+	//Backwards for the same reason as ApplyClimbers
+	for (int32 BatchIndex = Climbers.Num() - 1; BatchIndex >= 0; BatchIndex--)
+	{
+		UCustomMovementComponent* Climber = Climbers[BatchIndex];
+		if (!IsValid(Climber) || !Climber->UpdatedComponent)
+		{
+			RemoveClimberAt(BatchIndex);
+			continue;
+		}
+
+		//Surface probes and stop checks stay per climber, they need the scene
+		const bool bActive = Climber->PrepareBatchedClimbStep(DeltaTime);
+
+		//Stopping to climb unregisters the climber from inside the call
+		if (!Climbers.IsValidIndex(BatchIndex) || Climbers[BatchIndex] != Climber) continue;
+
+		ActiveFlags[BatchIndex] = bActive;
+		if (!bActive) continue;
+
+		Locations[BatchIndex] = Climber->UpdatedComponent->GetComponentLocation();
+		Rotations[BatchIndex] = Climber->UpdatedComponent->GetComponentQuat();
+		Velocities[BatchIndex] = Climber->Velocity;
+		Accelerations[BatchIndex] = Climber->GetCurrentAcceleration();
+		SurfaceLocations[BatchIndex] = Climber->CurrentClimbableSurfaceLocation;
+		SurfaceNormals[BatchIndex] = Climber->CurrentClimbableSurfaceNormal;
+		MaxSpeeds[BatchIndex] = Climber->MaxClimbSpeed;
+		CapsuleRadii[BatchIndex] = Climber->GetCharacterOwner()->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		BrakingDecelerations[BatchIndex] = Climber->MaxBreakClimbDecelation;
+	}
+}
+
+void UClimbBatchSubsystem::IntegrateClimbers(float DeltaTime)
+{
+	const int32 NumClimbers = Climbers.Num();
+
+	for (int32 BatchIndex = 0; BatchIndex < NumClimbers; BatchIndex++)
+	{
+		if (!ActiveFlags[BatchIndex]) continue;
+
+		//CalcVelocity with zero friction and the climb braking deceleration
+		FVector ClimbVelocity = Velocities[BatchIndex];
+		const FVector& ClimbAcceleration = Accelerations[BatchIndex];
+		const float MaxSpeed = MaxSpeeds[BatchIndex];
+
+		if (ClimbAcceleration.IsNearlyZero())
+		{
+			const float Speed = ClimbVelocity.Size();
+			const float BrakedSpeed = FMath::Max(Speed - BrakingDecelerations[BatchIndex] * DeltaTime, 0.f);
+			ClimbVelocity = Speed > UE_KINDA_SMALL_NUMBER ? ClimbVelocity * (BrakedSpeed / Speed) : FVector::ZeroVector;
+		}
+		else
+		{
+			ClimbVelocity = (ClimbVelocity + ClimbAcceleration * DeltaTime).GetClampedToMaxSize(MaxSpeed);
+		}
+
+		//GetClimbRotation
+		const FQuat& CurrentQuat = Rotations[BatchIndex];
+		const FVector& SurfaceNormal = SurfaceNormals[BatchIndex];
+		const FQuat TargetQuat = FRotationMatrix::MakeFromX(-SurfaceNormal).ToQuat();
+		const FQuat NewQuat = FMath::QInterpTo(CurrentQuat, TargetQuat, DeltaTime, 5.f);
+
+		//GetClimbSnapDelta
+		const FVector ProjectedCharacterToSurface = (SurfaceLocations[BatchIndex] - Locations[BatchIndex]).ProjectOnTo(CurrentQuat.GetForwardVector());
+		const double DistanceToSurface = ProjectedCharacterToSurface.Length();
+		const double SkinDistance = FMath::Max(DistanceToSurface - CapsuleRadii[BatchIndex], 0.0);
+		const FVector SnapDelta = -SurfaceNormal * FMath::Min(DistanceToSurface * DeltaTime * MaxSpeed, SkinDistance);
+
+		Velocities[BatchIndex] = ClimbVelocity;
+		Rotations[BatchIndex] = NewQuat;
+		MoveDeltas[BatchIndex] = ClimbVelocity * DeltaTime + SnapDelta;
+	}
+}
+
+void UClimbBatchSubsystem::ApplyClimbers(float DeltaTime)
+{
+	//Backwards, a climber that stops here unregisters and swaps an already applied one into its slot
+	for (int32 BatchIndex = Climbers.Num() - 1; BatchIndex >= 0; BatchIndex--)
+	{
+		if (!ActiveFlags[BatchIndex]) continue;
+
+		Climbers[BatchIndex]->FinishBatchedClimbStep(MoveDeltas[BatchIndex], Velocities[BatchIndex], Rotations[BatchIndex], DeltaTime);
+	}
+}
+
+TStatId UClimbBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbBatchSubsystem, STATGROUP_Tickables);
+}
+
+bool UClimbBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
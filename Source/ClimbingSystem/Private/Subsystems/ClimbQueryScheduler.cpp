@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ClimbQueryScheduler.h"
+#include "Components/CustomMovementComponent.h"
+#include "ClimbingSystem/ClimbingStats.h"
+#include "ClimbingSystem/DebugHelper.h"
+
+static TAutoConsoleVariable<float> CVarClimbQueryBudgetUs(
+	TEXT("Climb.Scheduler.BudgetUs"),
+	500.f,
+	TEXT("Microseconds of climb scene queries allowed per frame before AI probes are deferred"));
+
+static TAutoConsoleVariable<int32> CVarClimbQueryMaxWaitFrames(
+	TEXT("Climb.Scheduler.MaxWaitFrames"),
+	8,
+	TEXT("Frames a deferred climb query may wait before it runs regardless of the budget"));
+
+static FAutoConsoleCommandWithWorld ReportClimbSchedulerCommand(
+	TEXT("Climb.Scheduler.Report"),
+	TEXT("Logs how many climb queries the scheduler deferred and how long they waited"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UClimbQueryScheduler* Scheduler = World ? World->GetSubsystem<UClimbQueryScheduler>() : nullptr)
+		{
+			Debug::Print(FString::Printf(TEXT("Climb queries: %lld deferred, %d pending, average wait %.2f frames, max wait %llu frames"),
+				Scheduler->GetNumDeferredTotal(), Scheduler->GetNumPendingQueries(), Scheduler->GetAverageWaitFrames(), Scheduler->GetMaxWaitFrames()), FColor::Cyan);
+		}
+	})
+);
+
+bool UClimbQueryScheduler::TryAcquireBudget(EClimbQueryPriority Priority, uint64& InOutDeferredFrame)
+{
+	BeginFrameIfNeeded();
+
+	const bool bWaitedTooLong = InOutDeferredFrame != 0 && GFrameCounter - InOutDeferredFrame >= (uint64)CVarClimbQueryMaxWaitFrames.GetValueOnGameThread();
+
+	if (Priority >= EClimbQueryPriority::PlayerMaintenance || HasBudgetLeft() || bWaitedTooLong)
+	{
+		if (InOutDeferredFrame != 0)
+		{
+			RecordWait(InOutDeferredFrame);
+			InOutDeferredFrame = 0;
+		}
+		return true;
+	}
+
+	if (InOutDeferredFrame == 0)
+	{
+		InOutDeferredFrame = GFrameCounter;
+	}
+
+	NumDeferredThisFrame++;
+	NumDeferredTotal++;
+	INC_DWORD_STAT(STAT_ClimbQueriesDeferred);
+
+	return false;
+}
+
+void UClimbQueryScheduler::EnqueueQuery(UCustomMovementComponent* Requester, EClimbQueryKind Kind, EClimbQueryPriority Priority)
+{
+	BeginFrameIfNeeded();
+
+	//A repeated request keeps its place and age
+	for (const FPendingClimbQuery& PendingQuery : PendingQueries)
+	{
+		if (PendingQuery.Requester == Requester && PendingQuery.Kind == Kind) return;
+	}
+
+	PendingQueries.Add({ Requester, Kind, Priority, GFrameCounter });
+}
+
+void UClimbQueryScheduler::ChargeQueryCycles(uint64 Cycles)
+{
+	BeginFrameIfNeeded();
+
+	UsedMicroseconds += FPlatformTime::ToMilliseconds64(Cycles) * 1000.0;
+}
+
+void UClimbQueryScheduler::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const uint64 TickStartCycles = FPlatformTime::Cycles64();
+
+	BeginFrameIfNeeded();
+	RunPendingQueries();
+
+	LastTickCycles = FPlatformTime::Cycles64() - TickStartCycles;
+}
+
+void UClimbQueryScheduler::RunPendingQueries()
+{
+	if (PendingQueries.IsEmpty()) return;
+
+	const uint64 MaxWait = (uint64)CVarClimbQueryMaxWaitFrames.GetValueOnGameThread();
+
+	//Most urgent first, oldest first within the same priority
+	PendingQueries.StableSort([](const FPendingClimbQuery& A, const FPendingClimbQuery& B)
+	{
+		return A.Priority != B.Priority ? A.Priority > B.Priority : A.RequestFrame < B.RequestFrame;
+	});
+
+	//Running a query may queue new ones, so work from a detached list
+	TArray<FPendingClimbQuery> QueriesToRun = MoveTemp(PendingQueries);
+	PendingQueries.Reset();
+
+	int32 NumDeferred = 0;
+	for (int32 QueryIndex = 0; QueryIndex < QueriesToRun.Num(); QueryIndex++)
+	{
+		const FPendingClimbQuery& PendingQuery = QueriesToRun[QueryIndex];
+
+		const bool bWaitedTooLong = GFrameCounter - PendingQuery.RequestFrame >= MaxWait;
+		if (!HasBudgetLeft() && !bWaitedTooLong)
+		{
+			NumDeferred = QueriesToRun.Num() - QueryIndex;
+			PendingQueries.Append(&QueriesToRun[QueryIndex], NumDeferred);
+			break;
+		}
+
+		UCustomMovementComponent* Requester = PendingQuery.Requester.Get();
+		if (!IsValid(Requester)) continue;
+
+		RecordWait(PendingQuery.RequestFrame);
+
+		//Probe cost is charged by the component's trace functions as they run
+		Requester->RunScheduledClimbQuery(PendingQuery.Kind);
+	}
+
+	NumDeferredThisFrame += NumDeferred;
+	NumDeferredTotal += NumDeferred;
+	INC_DWORD_STAT_BY(STAT_ClimbQueriesDeferred, NumDeferred);
+}
+
+void UClimbQueryScheduler::BeginFrameIfNeeded()
+{
+	if (BudgetFrame == GFrameCounter) return;
+
+	BudgetFrame = GFrameCounter;
+	UsedMicroseconds = 0.0;
+	NumDeferredThisFrame = 0;
+}
+
+bool UClimbQueryScheduler::HasBudgetLeft() const
+{
+	return UsedMicroseconds < CVarClimbQueryBudgetUs.GetValueOnGameThread();
+}
+
+void UClimbQueryScheduler::RecordWait(uint64 RequestFrame)
+{
+	const uint64 WaitFrames = GFrameCounter - RequestFrame;
+
+	TotalWaitFrames += WaitFrames;
+	NumWaitSamples++;
+	MaxWaitFrames = FMath::Max(MaxWaitFrames, WaitFrames);
+}
+
+TStatId UClimbQueryScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbQueryScheduler, STATGROUP_Tickables);
+}
+
+bool UClimbQueryScheduler::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
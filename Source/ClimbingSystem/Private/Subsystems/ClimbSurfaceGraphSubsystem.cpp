@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ClimbSurfaceGraphSubsystem.h"
+#include "Data/ClimbSurfaceGraph.h"
+#include "Misc/PackageName.h"
+
+FString UClimbSurfaceGraphSubsystem::GetGraphPackageName(const FString& MapPackageName)
+{
+	const FString MapName = FPackageName::GetShortName(UWorld::RemovePIEPrefix(MapPackageName));
+	return FString::Printf(TEXT("/Game/ClimbGraphs/%s_ClimbGraph"), *MapName);
+}
+
+bool UClimbSurfaceGraphSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UClimbSurfaceGraphSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const FString GraphPackageName = GetGraphPackageName(InWorld.GetOutermost()->GetName());
+	if (!FPackageName::DoesPackageExist(GraphPackageName)) return;
+
+	const FString GraphObjectPath = GraphPackageName + TEXT(".") + FPackageName::GetShortName(GraphPackageName);
+	Graph = LoadObject<UClimbSurfaceGraph>(nullptr, *GraphObjectPath);
+}
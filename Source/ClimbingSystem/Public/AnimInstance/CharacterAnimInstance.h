@@ -20,7 +20,7 @@ class CLIMBINGSYSTEM_API UCharacterAnimInstance : public UAnimInstance
 public:
 #pragma region OverridenFunctions
 	virtual void NativeInitializeAnimation() override;
-	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 #pragma endregion
 
 private:
@@ -53,4 +53,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
 	FVector ClimbVelocity;
 	void GetClimbVelocity();
+
+	//One bit per EClimbHopDirection that currently has a hop target
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true", Bitmask, BitmaskEnum = "/Script/ClimbingSystem.EClimbHopDirection"))
+	int32 AvailableHops;
+	void GetAvailableHops();
 };
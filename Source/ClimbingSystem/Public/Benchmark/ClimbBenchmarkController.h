@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Controller.h"
+#include "ClimbBenchmarkController.generated.h"
+
+class AClimbingSystemCharacter;
+
+enum class EClimbBenchmarkAction : uint8
+{
+	None,
+	StartClimb,
+	StopClimb,
+	Hop,
+	ResetToWall,
+	ResetToVaultBox
+};
+
+struct FClimbBenchmarkStep
+{
+	//Held for the whole step, X is right and Y is forward/up like the climb input action
+	FVector2D MoveInput = FVector2D::ZeroVector;
+
+	//Fired once when the step begins
+	EClimbBenchmarkAction Action = EClimbBenchmarkAction::None;
+
+	float Duration = 0.f;
+};
+
+/**
+ * Drives one benchmark climber through a fixed script: climb, move, hop in every direction, climb to top and vault.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API AClimbBenchmarkController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	AClimbBenchmarkController();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	//Where the lane's wall run and vault run start, set by the benchmark game mode before possession
+	void InitLane(const FTransform& InWallStart, const FTransform& InVaultStart, float InScriptTimeOffset);
+
+private:
+	static const TArray<FClimbBenchmarkStep>& GetScript();
+
+	void BeginStep(const FClimbBenchmarkStep& Step);
+
+	void ApplyMoveInput(const FVector2D& MoveInput);
+
+	void ResetTo(const FTransform& StartTransform);
+
+	FTransform WallStart;
+
+	FTransform VaultStart;
+
+	int32 StepIndex = INDEX_NONE;
+
+	float StepTimeRemaining = 0.f;
+};
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "ClimbBenchmarkGameMode.generated.h"
+
+class ACharacter;
+class UCustomMovementComponent;
+
+/**
+ * Headless climbing benchmark. Builds an arena of walls, ledges, overhangs and vault boxes, spawns scripted climbers,
+ * records per-frame cost and writes a JSON report that can be compared against a stored baseline.
+ *
+ * UnrealEditor-Cmd ClimbingSystem.uproject /Game/ClimbSystem/Maps/<AnyMap>?game=/Script/ClimbingSystem.ClimbBenchmarkGameMode
+ *	-game -nullrhi -unattended -benchmark -fps=60
+ *	[-ClimbBenchCount=32] [-ClimbBenchWarmup=120] [-ClimbBenchFrames=1200]
+ *	[-ClimbBenchOutput=Path.json] [-ClimbBenchBaseline=Path.json] [-ClimbBenchTolerance=0.1]
+ *
+ * Exits with a non-zero code when the baseline is given and the movement tick or query count regressed past the tolerance.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API AClimbBenchmarkGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+	AClimbBenchmarkGameMode();
+
+	virtual void StartPlay() override;
+
+	virtual void Tick(float DeltaSeconds) override;
+
+private:
+	void BuildArena();
+
+	void SpawnBlock(const FVector& Center, const FVector& Size, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	void SpawnClimbers();
+
+	void RecordFrame();
+
+	void FinishBenchmark();
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	TSoftClassPtr<ACharacter> ClimberClass;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	FVector ArenaOrigin = FVector(100000.f, 0.f, 0.f);
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float LaneSpacing = 700.f;
+
+	UPROPERTY()
+	TArray<UCustomMovementComponent*> Climbers;
+
+	int32 NumClimbers = 32;
+
+	int32 NumWarmupFrames = 120;
+
+	int32 NumMeasuredFrames = 1200;
+
+	int32 FrameIndex = 0;
+
+	TArray<int32> PreviousQueryCounts;
+
+	TArray<double> FrameMovementTickMs;
+
+	TArray<double> FrameQueriesPerClimber;
+
+	uint64 StartUsedPhysicalMemory = 0;
+
+	uint64 PeakUsedPhysicalMemory = 0;
+
+	bool bFinished = false;
+};
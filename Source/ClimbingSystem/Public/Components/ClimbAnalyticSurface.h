@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Convex collision of the climbed primitive kept as bounding planes, so surface and ledge probes against it are answered
+ * without a scene query. Planes are cached in component space and only re-transformed when the component moves.
+ */
+struct FClimbAnalyticSurface
+{
+	//Single box or convex simple collision, or the local bounds of a component carrying PlanarTag. False for anything else
+	bool Build(UPrimitiveComponent& InPrimitive, FName PlanarTag);
+
+	void Reset();
+
+	FORCEINLINE bool IsValid() const { return !WorldPlanes.IsEmpty(); }
+
+	FORCEINLINE UPrimitiveComponent* GetPrimitive() const { return Primitive.Get(); }
+
+	//Follows the component if it moved since the last call, false once it is gone
+	bool Refresh();
+
+	//Closest point on the face the location is in front of. False inside the collision or within EdgeMargin of another face
+	bool FindSurface(const FVector& Location, float EdgeMargin, FVector& OutSurfaceLocation, FVector& OutSurfaceNormal) const;
+
+	//True only when the segment certainly enters the collision, a start inside it or a grazing pass is left to a trace
+	bool IntersectsSegment(const FVector& Start, const FVector& End) const;
+
+	//Distance along Direction from a location inside the footprint to the face the collision rests on, false without such a face
+	bool FindBottomFaceDistance(const FVector& Location, const FVector& Direction, float& OutDistance) const;
+
+	//Where and when the sweep that confirmed nothing else is around the primitive ran
+	FVector SweepLocation = FVector::ZeroVector;
+
+	float SweepTime = 0.f;
+
+private:
+	void AddLocalPlane(const FPlane& Plane);
+
+	void AddLocalBox(const FBox& Box, const FTransform& BoxTransform);
+
+	void UpdateWorldPlanes();
+
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+
+	FTransform PlanesTransform = FTransform::Identity;
+
+	TArray<FPlane, TInlineAllocator<16>> LocalPlanes;
+
+	TArray<FPlane, TInlineAllocator<16>> WorldPlanes;
+};
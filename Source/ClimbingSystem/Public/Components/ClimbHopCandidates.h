@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FClimbHopScoring
+{
+	//Where the hop input points, relative to the candidate origin
+	FVector IdealTarget = FVector::ZeroVector;
+
+	//Normal of the surface the climber hangs on, hops onto similar surfaces are preferred
+	FVector SurfaceNormal = FVector::ZeroVector;
+
+	//Candidates this far from the ideal target score zero for distance
+	float Reach = 150.f;
+
+	//Largest gap between a fan sample and the surface the climber can still reach across
+	float MaxGap = 80.f;
+
+	//Candidates on surfaces turned further than this from the current one are rejected
+	float MinNormalDot = 0.7f;
+
+	float DistanceWeight = 1.f;
+
+	float AngleWeight = 0.5f;
+
+	float ReachWeight = 0.5f;
+};
+
+/**
+ * Grab point candidates of an analog hop, stored as structure of arrays like FClimbSurfaceHits.
+ * Padding lanes carry an infinite gap so the scoring kernel rejects them without a scalar tail.
+ */
+struct FClimbHopCandidates
+{
+	static constexpr int32 LaneWidth = 4;
+
+	void Reset(const FVector& InOrigin);
+
+	//Gap is the distance between the fan sample and the candidate point on the surface
+	void Add(const FVector& Position, const FVector& Normal, float Gap);
+
+	FORCEINLINE int32 Num() const { return NumCandidates; }
+
+	FORCEINLINE FVector GetPosition(int32 CandidateIndex) const { return Origin + FVector(PositionX[CandidateIndex], PositionY[CandidateIndex], PositionZ[CandidateIndex]); }
+
+	//Scores four candidates per iteration, INDEX_NONE when every candidate is rejected
+	int32 FindBest(const FClimbHopScoring& Scoring) const;
+
+private:
+	using FLaneArray = TArray<float, TAlignedHeapAllocator<16>>;
+
+	FVector Origin = FVector::ZeroVector;
+
+	FLaneArray PositionX;
+	FLaneArray PositionY;
+	FLaneArray PositionZ;
+
+	FLaneArray NormalX;
+	FLaneArray NormalY;
+	FLaneArray NormalZ;
+
+	FLaneArray Gaps;
+
+	int32 NumCandidates = 0;
+};
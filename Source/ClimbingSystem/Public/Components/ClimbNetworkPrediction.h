@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/CharacterMovementReplication.h"
+
+//Climb requests ride in the custom compressed flag bits of each saved move
+namespace ClimbMoveFlags
+{
+	constexpr uint8 StartClimb = FSavedMove_Character::FLAG_Custom_0;
+	constexpr uint8 StopClimb = FSavedMove_Character::FLAG_Custom_1;
+	constexpr uint8 Hop = FSavedMove_Character::FLAG_Custom_2;
+}
+
+class FSavedMove_Climb : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	virtual void Clear() override;
+
+	virtual uint8 GetCompressedFlags() const override;
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+
+	virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
+
+	virtual void PrepMoveFor(ACharacter* C) override;
+
+	virtual void PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode) override;
+
+	uint8 bSavedWantsToStartClimbing : 1;
+
+	uint8 bSavedWantsToStopClimbing : 1;
+
+	uint8 bSavedWantsToHop : 1;
+
+	//Surface the client ended the move on, sent to the server for validation
+	uint8 bSavedIsClimbing : 1;
+
+	FVector SavedClimbSurfaceLocation;
+
+	FVector SavedClimbSurfaceNormal;
+
+	//Fixed climb step accumulator at the start of the move, restored before a replay
+	float SavedClimbStepAccumulator;
+
+	//Surface filter state at the start of the move, so a replay blends from what the move originally saw
+	FVector SavedFilteredClimbSurfaceNormal;
+
+	FVector SavedFilteredClimbSurfaceAnchor;
+
+	uint8 bSavedHasFilteredClimbSurface : 1;
+};
+
+class FNetworkPredictionData_Client_Climb : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_Climb(const UCharacterMovementComponent& ClientMovement);
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
+
+struct FClimbNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+	bool bIsClimbing = false;
+
+	FVector_NetQuantize10 ClimbSurfaceLocation;
+
+	FVector_NetQuantizeNormal ClimbSurfaceNormal;
+};
+
+struct FClimbNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FClimbNetworkMoveDataContainer();
+
+	FClimbNetworkMoveData ClimbDefaultMoveData[3];
+};
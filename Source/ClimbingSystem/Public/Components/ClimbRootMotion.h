@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/RootMotionSource.h"
+#include "ClimbRootMotion.generated.h"
+
+class UAnimMontage;
+
+//Motion warping notify window of a montage
+USTRUCT()
+struct FClimbWarpWindow
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	FName WarpTargetName;
+
+	UPROPERTY(VisibleAnywhere)
+	float StartTime = 0.f;
+
+	UPROPERTY(VisibleAnywhere)
+	float EndTime = 0.f;
+};
+
+//Root translation of a montage sampled at a fixed rate, so a server can replay it without evaluating the animation
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbRootMotionTrack
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	float SampleRate = 0.f;
+
+	UPROPERTY(VisibleAnywhere)
+	float PlayLength = 0.f;
+
+	//Montage default blend out, clients run the follow-up when blending out starts so the server ends this much early
+	UPROPERTY(VisibleAnywhere)
+	float BlendOutTime = 0.f;
+
+	//Root translation since the montage start, in mesh space
+	UPROPERTY(VisibleAnywhere)
+	TArray<FVector3f> Translations;
+
+	//Path length up to each sample, warp corrections are spread along it like the skew warp does
+	UPROPERTY(VisibleAnywhere)
+	TArray<float> Distances;
+
+	UPROPERTY(VisibleAnywhere)
+	TArray<FClimbWarpWindow> WarpWindows;
+
+	FORCEINLINE bool IsValid() const { return Translations.Num() > 1 && PlayLength > 0.f; }
+
+	void Bake(const UAnimMontage& Montage, float InSampleRate);
+
+	FVector EvaluateTranslation(float Time) const;
+
+	float EvaluateDistance(float Time) const;
+
+	//0 before the window, 1 after it, the share of the window's root path covered by Time in between
+	float GetWarpAlpha(const FClimbWarpWindow& Window, float Time) const;
+};
+
+/**
+ * Replays a baked climb action track as an override root motion source, with warp target corrections applied over each warp window.
+ * Used by dedicated servers in place of the montage, it finishes after exactly the montage's play length.
+ */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FRootMotionSource_ClimbAction : public FRootMotionSource
+{
+	GENERATED_BODY()
+
+	FRootMotionSource_ClimbAction();
+
+	//Index into the owning UCustomMovementComponent's climb actions, which owns the track
+	UPROPERTY()
+	uint8 ActionIndex = 0;
+
+	UPROPERTY()
+	FVector StartLocation = FVector::ZeroVector;
+
+	//Mesh rotation at the start, the track is in mesh space
+	UPROPERTY()
+	FQuat MeshRotation = FQuat::Identity;
+
+	//Offset each warp window adds by its end, parallel to the track's WarpWindows
+	UPROPERTY()
+	TArray<FVector> WarpCorrections;
+
+	void BuildWarpCorrections(const FClimbRootMotionTrack& Track, TConstArrayView<FName> WarpTargetNames, TConstArrayView<FVector> WarpTargetLocations, float CapsuleHalfHeight);
+
+	FVector EvaluateLocation(const FClimbRootMotionTrack& Track, float Time) const;
+
+	virtual FRootMotionSource* Clone() const override;
+
+	virtual bool Matches(const FRootMotionSource* Other) const override;
+
+	virtual void PrepareRootMotion(float SimulationTime, float MovementTickTime, const ACharacter& Character, const UCharacterMovementComponent& MoveComponent) override;
+
+	virtual bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) override;
+
+	virtual UScriptStruct* GetScriptStruct() const override;
+
+	virtual FString ToSimpleString() const override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FRootMotionSource_ClimbAction> : public TStructOpsTypeTraitsBase2<FRootMotionSource_ClimbAction>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
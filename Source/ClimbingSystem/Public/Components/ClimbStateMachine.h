@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbStateMachine.generated.h"
+
+UENUM(BlueprintType)
+enum class EClimbState : uint8
+{
+	None,
+	//Idle-to-climb or climb-down-ledge montage, still walking until it ends
+	Entering,
+	Hanging,
+	Moving,
+	Hopping,
+	//Climbing up onto a ledge
+	Mantling,
+	Vaulting,
+	Exiting
+};
+
+//Probes a climb state may issue, anything not listed for the current state is never run
+namespace ClimbProbes
+{
+	constexpr uint8 None = 0;
+	constexpr uint8 Surface = 1 << 0;
+	constexpr uint8 StopCheck = 1 << 1;
+	constexpr uint8 Floor = 1 << 2;
+	constexpr uint8 Ledge = 1 << 3;
+	constexpr uint8 Snap = 1 << 4;
+
+	//Probes that touch the scene, skipped on reduced LOD frames and charged to the query scheduler
+	constexpr uint8 SceneQueries = Surface | Floor | Ledge | Snap;
+
+	constexpr uint8 GetRequiredProbes(EClimbState State)
+	{
+		switch (State)
+		{
+		//Floor and ledge only trigger while moving down or up, a hanging climber cannot reach either
+		case EClimbState::Hanging:	return Surface | StopCheck | Snap;
+		case EClimbState::Moving:	return Surface | StopCheck | Floor | Ledge | Snap;
+
+		//Transitions are root motion montages warped to targets picked before they started
+		default:					return None;
+		}
+	}
+}
+
+namespace ClimbStates
+{
+	constexpr bool IsFreeClimbing(EClimbState State)
+	{
+		return State == EClimbState::Hanging || State == EClimbState::Moving;
+	}
+
+	constexpr bool IsTransition(EClimbState State)
+	{
+		return State == EClimbState::Entering || State == EClimbState::Hopping || State == EClimbState::Mantling || State == EClimbState::Vaulting;
+	}
+}
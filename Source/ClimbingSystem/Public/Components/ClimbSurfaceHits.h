@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+
+struct FClimbSurfaceFitSettings
+{
+	//Hits whose normal is further than this from the current estimate are rejected
+	float MinNormalDot = 0.7f;
+
+	//Distance off the plane at which a hit's weight has dropped to one half
+	float ResidualScale = 10.f;
+
+	//Smallest in-plane spread of the hits before their positions are trusted to tilt the plane
+	float MinPointSpread = 5.f;
+
+	int32 NumIterations = 2;
+};
+
+//Plane fitted to a sweep, Confidence is 0 for scattered or disagreeing hits and 1 for a clean flat surface
+struct FClimbSurfaceFit
+{
+	FVector Location = FVector::ZeroVector;
+
+	FVector Normal = FVector::ZeroVector;
+
+	float Confidence = 0.f;
+
+	int32 NumInliers = 0;
+};
+
+/**
+ * The parts of a climb sweep the climb checks actually read, stored as structure of arrays.
+ * Positions are kept relative to the sweep origin so they stay precise as floats far from the world origin.
+ * Every lane is padded with zeros to a multiple of four so the reductions never need a scalar tail.
+ */
+struct FClimbSurfaceHits
+{
+	static constexpr int32 LaneWidth = 4;
+
+	void Reserve(int32 NumHits);
+
+	void Reset(const FVector& InOrigin);
+
+	void Add(const FHitResult& Hit);
+
+	FORCEINLINE int32 Num() const { return NumHits; }
+
+	FORCEINLINE bool IsEmpty() const { return NumHits == 0; }
+
+	FORCEINLINE FVector GetPosition(int32 HitIndex) const { return Origin + FVector(PositionX[HitIndex], PositionY[HitIndex], PositionZ[HitIndex]); }
+
+	FORCEINLINE FVector GetNormal(int32 HitIndex) const { return FVector(NormalX[HitIndex], NormalY[HitIndex], NormalZ[HitIndex]); }
+
+	FORCEINLINE int32 GetNumPrimitives() const { return Primitives.Num(); }
+
+	UPrimitiveComponent* GetPrimitive(int32 HitIndex) const;
+
+	//Average impact point and normalized sum of impact normals, four hits per iteration
+	void ReduceCentroidAndNormal(FVector& OutCentroid, FVector& OutNormal) const;
+
+	//Iteratively reweighted plane fit that rejects hits off the dominant plane, returns false when nothing survives
+	bool FitPlane(const FClimbSurfaceFitSettings& Settings, FClimbSurfaceFit& OutFit) const;
+
+private:
+	using FLaneArray = TArray<float, TAlignedHeapAllocator<16>>;
+
+	FVector Origin = FVector::ZeroVector;
+
+	FLaneArray PositionX;
+	FLaneArray PositionY;
+	FLaneArray PositionZ;
+
+	FLaneArray NormalX;
+	FLaneArray NormalY;
+	FLaneArray NormalZ;
+
+	//Full int32 so a sweep over many distinct primitives can never alias another primitive's index
+	TArray<int32> PrimitiveIndices;
+
+	//Side table of the distinct primitives hit, a climb sweep rarely touches more than a couple
+	TArray<TWeakObjectPtr<UPrimitiveComponent>, TInlineAllocator<4>> Primitives;
+
+	int32 NumHits = 0;
+};
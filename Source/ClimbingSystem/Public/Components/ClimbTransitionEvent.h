@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbTransitionEvent.generated.h"
+
+//Climb actions never use more warp targets than this
+constexpr int32 MaxClimbTransitionWarpTargets = 4;
+
+/**
+ * Climb action the server started, replicated to simulated proxies so they rebuild the warp targets and montage locally
+ * instead of receiving montage state.
+ */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbTransitionEvent
+{
+	GENERATED_BODY()
+
+	//Index into the climb action table
+	UPROPERTY()
+	uint8 ActionId = 0;
+
+	//Bumped on every event so the same action twice in a row still replicates
+	UPROPERTY()
+	uint8 Sequence = 0;
+
+	//Server world time the action started at, remotes skip the part of the montage they missed
+	UPROPERTY()
+	float ServerTimestamp = 0.f;
+
+	//Server character location the action started from, the proxy may already have moved on by the time the event arrives
+	FVector StartLocation = FVector::ZeroVector;
+
+	//Warp targets relative to StartLocation, sent as whole centimetres
+	TArray<FVector, TInlineAllocator<MaxClimbTransitionWarpTargets>> WarpTargetOffsets;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbTransitionEvent> : public TStructOpsTypeTraitsBase2<FClimbTransitionEvent>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -4,6 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/OverlapResult.h"
+#include "Components/ClimbNetworkPrediction.h"
+#include "Components/ClimbSurfaceHits.h"
+#include "Components/ClimbHopCandidates.h"
+#include "Components/ClimbAnalyticSurface.h"
+#include "Components/ClimbStateMachine.h"
+#include "Components/ClimbTransitionEvent.h"
+#include "Data/ClimbActionSet.h"
+#include "Data/ClimbSurfaceGraph.h"
 #include "CustomMovementComponent.generated.h"
 
 DECLARE_DELEGATE(FOnEnterClimbState)
@@ -12,6 +21,10 @@ DECLARE_DELEGATE(FOnExitClimbState)
 class UAnimMontage;
 class UAnimInstance;
 class AClimbingSystemCharacter;
+class UClimbSurfaceGraph;
+class UClimbQueryScheduler;
+enum class EClimbQueryKind : uint8;
+struct FStreamableHandle;
 
 UENUM(BlueprintType)
 namespace ECustomMovementMode
@@ -22,6 +35,138 @@ namespace ECustomMovementMode
 	};
 }
 
+//Movement state captured at the end of every movement tick for the animation worker threads
+USTRUCT(BlueprintType)
+struct FClimbAnimSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector Acceleration = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector UnrotatedClimbVelocity = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsFalling = false;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsClimbing = false;
+
+	//One bit per EClimbHopDirection, from the background hop probes
+	UPROPERTY(BlueprintReadOnly, meta = (Bitmask, BitmaskEnum = "/Script/ClimbingSystem.EClimbHopDirection"))
+	int32 AvailableHops = 0;
+};
+
+//Climbed surface as simulated proxies see it, each field only replicates once it moved past its quantization
+USTRUCT()
+struct FClimbReplicatedSurface
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize10 Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Normal = FVector::ZeroVector;
+};
+
+//Component transform and basis vectors shared by every climb probe issued in the same tick
+struct FClimbQueryFrame
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Quat = FQuat::Identity;
+	FVector Forward = FVector::ForwardVector;
+	FVector Right = FVector::RightVector;
+	FVector Up = FVector::UpVector;
+};
+
+//Planar surface found by the last full capsule sweep, re-validated with a single line probe while it stays close
+struct FClimbSurfaceCache
+{
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+
+	FVector SurfaceLocation = FVector::ZeroVector;
+
+	FVector SurfaceNormal = FVector::ZeroVector;
+
+	FVector SweepLocation = FVector::ZeroVector;
+
+	float SweepTime = 0.f;
+
+	bool bValid = false;
+};
+
+//Every probe ToggleClimbing needs to pick between climb, ledge-down and vault
+enum class EClimbEntryProbe : uint8
+{
+	Surface,
+	EyeHeight,
+	LedgeWalkable,
+	LedgeDrop,
+	VaultStart,
+	VaultLand,
+	Num
+};
+
+//One in-flight batch of async entry probes, resolved once every result has come back
+struct FClimbEntryProbeBatch
+{
+	uint32 BatchId = 0;
+
+	uint8 PendingCount = 0;
+
+	bool bInFlight = false;
+
+	TStaticArray<bool, (int32)EClimbEntryProbe::Num> bBlockingHits;
+
+	TStaticArray<FVector, (int32)EClimbEntryProbe::Num> ImpactPoints;
+};
+
+//Hop probes issued together in the background while climbing
+enum class EClimbHopProbe : uint8
+{
+	Up,
+	UpSafety,
+	Down,
+	Right,
+	Left,
+	Num
+};
+
+struct FClimbHopProbeBatch
+{
+	uint32 BatchId = 0;
+
+	uint8 PendingCount = 0;
+
+	bool bInFlight = false;
+
+	FVector IssueLocation = FVector::ZeroVector;
+
+	TStaticArray<bool, (int32)EClimbHopProbe::Num> bBlockingHits;
+
+	TStaticArray<FVector, (int32)EClimbHopProbe::Num> ImpactPoints;
+};
+
+//Hops the last completed background batch found, indexed by EClimbHopDirection
+struct FClimbHopAvailability
+{
+	uint8 AvailableHops = 0;
+
+	TStaticArray<FVector, 4> Targets;
+
+	//Where the climber was when the probes went out
+	FVector SourceLocation = FVector::ZeroVector;
+
+	double Time = 0.0;
+
+	bool bValid = false;
+};
+
 /**
  * 
  */
@@ -30,7 +175,13 @@ class CLIMBINGSYSTEM_API UCustomMovementComponent : public UCharacterMovementCom
 {
 	GENERATED_BODY()
 
+	friend class UClimbBatchSubsystem;
+	friend class FSavedMove_Climb;
+	friend class UClimbQueryScheduler;
+
 public:
+	UCustomMovementComponent();
+
 	FOnEnterClimbState OnEnterClimbStateDelegate;
 	FOnExitClimbState OnExitClimbStateDelegate;
 	
@@ -38,6 +189,16 @@ protected:
 #pragma region OverridenFunctions
 	virtual void BeginPlay() override;
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientLoc, const FVector& RelativeClientLoc, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
@@ -54,13 +215,181 @@ protected:
 
 private:
 #pragma region ClimbTraces
-	TArray<FHitResult> DoCapsuleTraceMultiByObject(const FVector& Start, const FVector& End, bool bShowDebugShape = false, bool bDrawPersistantShape = false);
+	void InitClimbQueryParams();
+
+	void RefreshClimbQueryFrame();
+
+	bool DoCapsuleTraceMultiByObject(const FVector& Start, const FVector& End, FClimbSurfaceHits& OutHits, bool bShowDebugShape = false, bool bDrawPersistantShape = false);
 
 	FHitResult DoLineTraceSingleByObject(const FVector& Start, const FVector& End, bool bShowDebugShape = false, bool bDrawPersistantShape = false);
+
+	//Answers from the baked climb graph when it covers the probe, otherwise falls back to a line trace
+	FHitResult DoClimbProbe(const FVector& Start, const FVector& End, bool bShowDebugShape = false, bool bDrawPersistantShape = false);
+
+	const UClimbSurfaceGraph* GetBakedClimbGraph() const;
+
+	bool ValidateClimbTarget(const FVector& InTargetPosition);
+
+	UClimbQueryScheduler* GetClimbQueryScheduler() const;
+
+	void ChargeClimbQueryCycles(uint64 StartCycles);
+
+	//False when the scheduler has no budget left for this climber's per-frame probes
+	bool AcquireClimbMaintenanceBudget();
+
+	void RunScheduledClimbQuery(EClimbQueryKind Kind);
+#pragma endregion
+
+
+#pragma region ClimbAsyncProbes
+	void RequestClimbEntryProbes();
+
+	void IssueClimbEntryLineProbe(EClimbEntryProbe Probe, const FVector& Start, const FVector& End);
+
+	void OnClimbEntryProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	void ResolveClimbEntryProbes();
+
+	FTraceDelegate ClimbEntryProbeDelegate;
+
+	FClimbEntryProbeBatch ClimbEntryProbeBatch;
+
+	//Keeps the hop availability map refreshed at HopAvailabilityRefreshRate while free climbing
+	void UpdateHopAvailability(float DeltaTime);
+
+	void RequestHopAvailabilityProbes();
+
+	void IssueHopAvailabilityProbe(EClimbHopProbe Probe, const FVector& Start, const FVector& End);
+
+	void OnHopAvailabilityProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	void ResolveHopAvailabilityProbes();
+
+	//Recent enough and taken close enough to where the climber is now to answer a hop request
+	bool IsHopAvailabilityFresh() const;
+
+	//A fresh availability map answers for the locally controlled climber, hit or miss. Otherwise the baked graph or a synchronous probe does
+	bool ResolveHopTarget(EClimbHopDirection Direction, FVector& OutTargetPosition);
+
+	FTraceDelegate HopAvailabilityProbeDelegate;
+
+	FClimbHopProbeBatch HopAvailabilityProbeBatch;
+
+	FClimbHopAvailability HopAvailability;
+
+	float HopAvailabilityTimer = 0.f;
+#pragma endregion
+
+
+#pragma region ClimbActions
+	//Builds the action table from ClimbActionSet, or from the legacy montage properties when no set is assigned
+	void InitClimbActions();
+
+	void AddLegacyClimbAction(FName ActionName, UAnimMontage* Montage, EClimbState State, EClimbActionFollowUp FollowUp, TArray<FName>&& WarpTargetNames = {});
+
+	//Streams the action montages in while a climbable surface is near and lets them go again once it has been away for a while
+	void UpdateClimbActionStreaming(float DeltaTime);
+
+	void RequestClimbActionMontages();
+
+	void OnClimbActionMontagesLoaded();
+
+	void ReleaseClimbActionMontages();
+
+	UAnimMontage* ResolveClimbActionMontage(int32 ActionIndex);
+
+	void PlayClimbAction(FName ActionName, TConstArrayView<FVector> WarpTargetLocations = {});
+
+	const FClimbActionDefinition* FindClimbActionForMontage(const UAnimMontage* Montage) const;
+
+	//Follow-up and state reset once an action's montage or server root motion has finished
+	void OnClimbActionEnded(const FClimbActionDefinition* Action);
+
+	//Dedicated servers replay baked root motion instead of playing montages, so the mesh never has to evaluate a pose
+	bool ShouldUseServerClimbActions() const;
+
+	const FClimbRootMotionTrack* ResolveClimbRootMotionTrack(int32 ActionIndex);
+
+	bool PlayServerClimbAction(int32 ActionIndex, TConstArrayView<FVector> WarpTargetLocations);
+
+	void ReplicateClimbTransition(int32 ActionIndex, TConstArrayView<FVector> WarpTargetLocations);
+
+	UFUNCTION()
+	void OnRep_ClimbTransition();
+
+	void UpdateServerClimbAction();
+
+	//The shared ClimbActionSet array, or LegacyClimbActions when no set is assigned. Read through the set on every call, an edit or
+	//reload of the asset reallocates its array. Capped to the tables InitClimbActions sized, so parallel arrays stay in bounds
+	FORCEINLINE TConstArrayView<FClimbActionDefinition> GetClimbActions() const
+	{
+		const TConstArrayView<FClimbActionDefinition> Actions = ClimbActionSet ? TConstArrayView<FClimbActionDefinition>(ClimbActionSet->GetActions()) : TConstArrayView<FClimbActionDefinition>(LegacyClimbActions);
+		return Actions.Left(FMath::Min(Actions.Num(), ClimbActionMontages.Num()));
+	}
+
+	TArray<FClimbActionDefinition> LegacyClimbActions;
+
+	//Root motion baked on first use for actions saved without it, empty unless that happens
+	TArray<FClimbRootMotionTrack> RuntimeClimbRootMotionTracks;
+
+	//Loaded montage per action, null until streamed in
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAnimMontage>> ClimbActionMontages;
+
+	TMap<FName, uint8> ClimbActionIndexByName;
+
+	TMap<TObjectKey<UAnimMontage>, uint8> ClimbActionIndexByMontage;
+
+	TSharedPtr<FStreamableHandle> ClimbActionStreamHandle;
+
+	float ClimbActionStreamTimer = 0.f;
+
+	float ClimbActionReleaseTimer = 0.f;
+
+	//Every action has a baked server track, a server climb mode never needs the montages themselves
+	bool bAllClimbActionsBaked = false;
+
+	int32 ServerClimbActionIndex = INDEX_NONE;
+
+	uint16 ServerClimbActionRootMotionID = 0;
+
+	//Last climb action the server started, simulated proxies replay it on their side
+	UPROPERTY(ReplicatedUsing = OnRep_ClimbTransition)
+	FClimbTransitionEvent ReplicatedClimbTransition;
+#pragma endregion
+
+
+#pragma region ClimbReplication
+	//Picks the owner's net update frequency for the current climb state
+	void UpdateClimbNetUpdateFrequency();
+
+	void UpdateReplicatedClimbSurface();
+
+	UFUNCTION()
+	void OnRep_ClimbSurface();
+
+	UPROPERTY(ReplicatedUsing = OnRep_ClimbSurface)
+	FClimbReplicatedSurface ReplicatedClimbSurface;
+
+	//Owner's frequency outside of climbing
+	float DefaultNetUpdateFrequency = 0.f;
 #pragma endregion
 
 
 #pragma region ClimbCore
+	void ExecuteToggleClimbing(bool bEnableClimb);
+
+	void ExecuteHopping();
+
+	//Scores a fan of grab points around the input direction and hops to the best one, false when none qualifies
+	bool TryAnalogHop(const FVector& UnrotatedInput);
+
+	//Hop target offset along the wall for a direction in the wall plane, each axis as far as its cardinal hop
+	FVector GetAnalogHopOffset(const FVector& HopDirection) const;
+
+	//Fills AnalogHopCandidates from the primitives around IdealTarget, one overlap for the whole fan
+	void GatherAnalogHopCandidates(const FVector& HopDirection, const FVector& IdealTarget, float SampleDepth);
+
 	bool TraceClimbableSurfaces();
 
 	FHitResult TraceFromEyeHeight(float TraceDistance, float TraceStartOffset = 0.f, bool bShowDebugShape = false, bool bDrawPersistantShape = false);
@@ -77,7 +406,39 @@ private:
 
 	void PhysClimb(float deltaTime, int32 Iterations);
 
-	void ProcessClimbableSurfaceInfo();
+	void UpdateClimbAnimSnapshot();
+
+	//One climb integration step, PhysClimb runs it once per frame or several times at the fixed climb rate
+	void IntegrateClimbStep(float StepTime);
+
+	void UpdateClimbStepInterpolation();
+
+	void UpdateClimbLOD();
+
+	//False on the frames a reduced LOD climber skips its surface, floor and ledge probes
+	bool IsFullClimbLODFrame() const;
+
+	bool PrepareBatchedClimbStep(float DeltaTime);
+
+	void FinishBatchedClimbStep(const FVector& MoveDelta, const FVector& NewVelocity, const FQuat& NewRotation, float DeltaTime);
+
+	void UpdateClimbBatchRegistration();
+
+	void ProcessClimbableSurfaceInfo(float DeltaTime);
+
+	void FilterClimbSurfaceFit(const FClimbSurfaceFit& Fit, float DeltaTime);
+
+	bool TryReuseClimbableSurface();
+
+	void CacheClimbableSurface();
+
+	//Answers the surface from the cached collision of the climbed primitive, false near its edges or once the sweep is due
+	bool TryAnalyticClimbableSurface();
+
+	void CacheAnalyticClimbSurface();
+
+	//Still the only thing the last sweep found, not due for another sweep and not moved away from
+	bool IsAnalyticClimbSurfaceUsable();
 
 	bool CheckShouldStopClimbing();
 
@@ -85,7 +446,8 @@ private:
 
 	FQuat GetClimbRotation(float DeltaTime);
 
-	void SnapMovementToClimbableSurfaces(float DeltaTime);
+	//Pull towards the climbed surface for one step, added to the climb move rather than swept on its own
+	FVector GetClimbSnapDelta(float DeltaTime) const;
 
 	bool CheckHasReachedLedge();
 
@@ -93,7 +455,17 @@ private:
 
 	bool CanStartVaulting(FVector& OutVaultStartPosition, FVector& OutVaultLandPosition);
 
-	void PlayClimbMontage(UAnimMontage* MontageToPlay);
+	bool PlayClimbMontage(UAnimMontage* MontageToPlay, float StartTime = 0.f);
+
+	EClimbState GetClimbStateForMontage(const UAnimMontage* Montage) const;
+
+	void SetClimbState(EClimbState NewState);
+
+	//Switches between Hanging and Moving, leaves every other state alone
+	void UpdateFreeClimbState();
+
+	//Probes the current state needs this tick, after LOD and scheduler budget
+	uint8 ResolveClimbProbes();
 
 	UFUNCTION()
 	void OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted);
@@ -119,7 +491,82 @@ private:
 
 
 #pragma region ClimbCoreVariables
-	TArray<FHitResult> ClimbableSurfacesTracedResults;
+	//Hit buffers are owned by the component and reused every tick, so steady state climbing never touches the heap
+	FClimbSurfaceHits ClimbableSurfaceHits;
+
+	FClimbSurfaceHits FloorHits;
+
+	FClimbHopCandidates AnalogHopCandidates;
+
+	TArray<FOverlapResult> AnalogHopOverlaps;
+
+	FCollisionObjectQueryParams ClimbObjectQueryParams;
+
+	FCollisionQueryParams ClimbQueryParams;
+
+	FClimbQueryFrame ClimbQueryFrame;
+
+	FClimbSurfaceCache ClimbSurfaceCache;
+
+	FClimbAnalyticSurface AnalyticClimbSurface;
+
+	//Temporally filtered plane the robust fit feeds, only its offset along the normal is smoothed so sliding along it never lags
+	FVector FilteredClimbSurfaceNormal = FVector::ZeroVector;
+
+	//Last filtered surface point, depth is smoothed relative to it so precision does not depend on the distance to the world origin
+	FVector FilteredClimbSurfaceAnchor = FVector::ZeroVector;
+
+	float ClimbSurfaceConfidence = 0.f;
+
+	bool bHasFilteredClimbSurface = false;
+
+	//Time not yet consumed by a fixed climb step, carried into the next frame
+	float ClimbStepAccumulator = 0.f;
+
+	FTransform ClimbStepPreviousTransform;
+
+	bool bHasClimbStepInterpolation = false;
+
+	bool bClimbMeshInterpolated = false;
+
+	//0 is full fidelity, 1 reduced and 2 minimal
+	int32 ClimbLOD = 0;
+
+	float ClimbLODUpdateTimer = 0.f;
+
+	float ClimbLODFullFidelityEndTime = 0.f;
+
+	EClimbState ClimbState = EClimbState::None;
+
+	//ClimbProbes flags the current tick may run, the state's required probes minus any the LOD or scheduler held back
+	uint8 ActiveClimbProbes = ClimbProbes::None;
+
+	//Frame the scheduler first skipped this climber's maintenance probes, 0 while it is not being skipped
+	uint64 ClimbMaintenanceDeferredFrame = 0;
+
+	FClimbAnimSnapshot ClimbAnimSnapshot;
+
+	//Requests raised by input, sent with the next saved move and executed at the start of that move on client and server
+	bool bWantsToStartClimbing = false;
+
+	bool bWantsToStopClimbing = false;
+
+	bool bWantsToHop = false;
+
+	FClimbNetworkMoveDataContainer ClimbNetworkMoveDataContainer;
+
+	//Corrections the server sent to this character, for Climb.Net.ReportCorrections
+	int32 NumServerCorrections = 0;
+
+	int32 NumClimbSurfaceCorrections = 0;
+
+	//Scene queries issued and cycles spent in the last movement tick, read by the climb benchmark
+	int32 NumClimbQueriesIssued = 0;
+
+	uint64 LastMovementTickCycles = 0;
+
+	//Slot in UClimbBatchSubsystem while this climber is integrated by the batch, INDEX_NONE otherwise
+	int32 ClimbBatchIndex = INDEX_NONE;
 
 	FVector CurrentClimbableSurfaceLocation;
 
@@ -143,6 +590,9 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
 	float ClimbCapsuleTraceHalfHeight = 72;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", ClampMin = "1"))
+	int32 ClimbHitBufferReserve = 16;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
 	float MaxBreakClimbDecelation = 400.f;
 
@@ -158,6 +608,194 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
 	float ClimbDownLedgeTraceOffset = 50.f;
 
+	//AI climbers hand their climb integration to UClimbBatchSubsystem, player controlled characters always keep the component path
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseBatchedClimbMovement = false;
+
+	//Integrate free climbing at a fixed rate and draw the mesh between steps, so climbing behaves the same at any frame or server tick rate
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseFixedClimbStep = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseFixedClimbStep", ClampMin = "10"))
+	float ClimbSubstepRate = 60.f;
+
+	//Frame time beyond this many steps is dropped so a hitch cannot snowball into more work
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseFixedClimbStep", ClampMin = "1"))
+	int32 MaxClimbSubstepsPerFrame = 4;
+
+	//Let AI climbers far from every player view probe and snap less often, players are never reduced
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbLOD = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbLOD"))
+	float ClimbLODReducedDistance = 2500.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbLOD"))
+	float ClimbLODMinimalDistance = 6000.f;
+
+	//Reduced climbers trace, snap and check for floors and ledges on one frame out of this many
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbLOD", ClampMin = "1"))
+	int32 ClimbLODReducedFrameInterval = 2;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbLOD", ClampMin = "1"))
+	int32 ClimbLODMinimalFrameInterval = 6;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbLOD"))
+	float ClimbLODUpdateInterval = 0.25f;
+
+	//Route climb probes through UClimbQueryScheduler, AI probes then wait for budget while player probes only count against it
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbQueryScheduler = false;
+
+	//Replicate the owner less often while hanging still and more often during transitions
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbNetUpdateFrequency = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbNetUpdateFrequency"))
+	float ClimbIdleNetUpdateFrequency = 10.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbNetUpdateFrequency"))
+	float ClimbMovingNetUpdateFrequency = 30.f;
+
+	//Hops, vaults, mantles and getting on or off the wall
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbNetUpdateFrequency"))
+	float ClimbTransitionNetUpdateFrequency = 60.f;
+
+	//Probe every hop direction in the background while climbing, so a hop press is a lookup instead of a trace burst
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseHopAvailabilityMap = false;
+
+	//Background hop probe batches per second
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseHopAvailabilityMap"))
+	float HopAvailabilityRefreshRate = 10.f;
+
+	//A map taken further away than this is not trusted for a hop, the hop probes synchronously instead
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseHopAvailabilityMap"))
+	float HopAvailabilityMaxDrift = 20.f;
+
+	//Hop toward any of eight directions, picking the best grab point in a fan around the input instead of a single cardinal trace
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseAnalogHop = false;
+
+	//Preferred sideways hop length, up and down hops keep the lengths of the cardinal hop probes
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalogHop"))
+	float AnalogHopDistance = 110.f;
+
+	//Candidates this far from the preferred target score nothing for distance
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalogHop"))
+	float AnalogHopReach = 150.f;
+
+	//Half angle of the candidate fan around the input direction
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalogHop", ClampMin = "0.0", ClampMax = "90.0"))
+	float AnalogHopFanAngle = 40.f;
+
+	//Furthest a grab point may sit off the climbed plane, further ones are out of reach
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalogHop"))
+	float AnalogHopMaxGap = 80.f;
+
+	//Send the climbed surface to simulated proxies as quantized location and normal fields, e.g. for hand IK
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bReplicateClimbSurface = false;
+
+	//Full fidelity is held this long after a climb, hop or mode change request
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbLOD"))
+	float ClimbLODTransitionHoldTime = 0.5f;
+
+	//Server forces a correction when the surface normal the client climbed on differs by more than this many degrees
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	float ClimbSurfaceNormalErrorTolerance = 10.f;
+
+	//Answer surface and ledge probes from the climbed primitive's box or convex collision, tracing only near its edges
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseAnalyticClimbSurface = false;
+
+	//Components with this tag are treated as their bounding box whatever their collision, for flat walls with complex collision
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalyticClimbSurface"))
+	FName AnalyticClimbPlanarTag = FName("ClimbPlanar");
+
+	//Closer than this to an edge of the climbed face the surface is swept again
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalyticClimbSurface"))
+	float AnalyticClimbEdgeMargin = 60.f;
+
+	//Sweep again after this long or this far from the last sweep, in case other geometry came into reach
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalyticClimbSurface"))
+	float AnalyticClimbRevalidateTime = 1.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseAnalyticClimbSurface"))
+	float AnalyticClimbRevalidateDistance = 200.f;
+
+	//Skip the per-tick capsule sweep while a single line probe confirms the character is still on the same flat surface
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbSurfaceCache = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbSurfaceCache"))
+	float ClimbSurfaceCacheMaxDistance = 30.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbSurfaceCache"))
+	float ClimbSurfaceCacheMaxTime = 0.25f;
+
+	//Minimum dot product between cached and probed normals for the surface to count as the same plane
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseClimbSurfaceCache"))
+	float ClimbSurfaceCacheNormalTolerance = 0.995f;
+
+	//Fit the climbed plane with outlier rejection and smooth it over time instead of averaging every hit, for corners, pipes and rough meshes
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseRobustSurfaceFit = false;
+
+	//Hits whose normal is more than this many degrees from the fitted plane are ignored
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseRobustSurfaceFit", ClampMin = "0", ClampMax = "90"))
+	float SurfaceFitOutlierAngle = 45.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseRobustSurfaceFit"))
+	float SurfaceFitResidualScale = 10.f;
+
+	//How quickly the filtered plane follows a fully confident fit, low confidence fits are followed more slowly
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseRobustSurfaceFit"))
+	float SurfaceFilterRate = 15.f;
+
+	//A fit that turns further than this from the filtered plane is a new surface and replaces it outright
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseRobustSurfaceFit"))
+	float SurfaceFilterResetAngle = 50.f;
+
+	//Answer hop and ledge probes from the level's baked climb graph instead of scene queries where it has coverage
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseBakedClimbGraph = false;
+
+	//Confirm a baked hop target with one short trace before committing to it, in case the level changed since the bake
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseBakedClimbGraph"))
+	bool bValidateBakedClimbTargets = true;
+
+	//How far a baked grab point may sit from a probe ray and still count as a hit, roughly the bake spacing
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseBakedClimbGraph"))
+	float BakedClimbGraphTolerance = 20.f;
+
+	//Issue climb, ledge-down and vault probes as one async batch and decide on the next frame instead of tracing synchronously on input
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseAsyncClimbEntryProbes = false;
+
+	//Montages, warp targets and follow-ups of every climb action, streamed in on demand. The montages below are only used when this is unset.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UClimbActionSet> ClimbActionSet;
+
+	//Start streaming the action montages once a climbable surface is within this distance
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	float ClimbActionStreamRadius = 600.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	float ClimbActionStreamCheckInterval = 0.5f;
+
+	//Release the streamed montages after this long without a climbable surface in range
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	float ClimbActionReleaseDelay = 15.f;
+
+	//On dedicated servers, drive climb actions from root motion baked out of the montages and stop evaluating animation
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseServerClimbActions = false;
+
+	//Sample rate for tracks baked at runtime from the legacy montages, assets bake with their own rate on save
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bUseServerClimbActions"))
+	float ServerRootMotionSampleRate = 30.f;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
 	UAnimMontage* IdleToClimbMontage;
 
@@ -192,6 +830,52 @@ public:
 
 	FORCEINLINE FVector GetClimbableSurfaceNormal() const { return CurrentClimbableSurfaceNormal; }
 
+	FORCEINLINE const TArray<TEnumAsByte<EObjectTypeQuery> >& GetClimbableSurfaceTraceTypes() const { return ClimbableSurfaceTraceTypes; }
+
+	//Length of the cardinal hop the CheckCanHop probes and montages were authored for, along the wall from where the character hangs
+	static float GetCardinalHopDistance(EClimbHopDirection Direction, float EyeHeight);
+
 	FVector GetUnrotatedClimbVelocity() const;
 
+	//Written once per movement tick, safe to read from NativeThreadSafeUpdateAnimation
+	FORCEINLINE const FClimbAnimSnapshot& GetClimbAnimSnapshot() const { return ClimbAnimSnapshot; }
+
+	//Keep this climber at full climb fidelity for a while, e.g. when gameplay is about to make it significant
+	void RequestFullClimbFidelity(float Duration);
+
+	FORCEINLINE EClimbState GetClimbState() const { return ClimbState; }
+
+	FORCEINLINE int32 GetClimbLOD() const { return ClimbLOD; }
+
+	FORCEINLINE float GetClimbSurfaceConfidence() const { return ClimbSurfaceConfidence; }
+
+	//Bitmask of EClimbHopDirection the background probes last found a target for, e.g. for hop prompts
+	UFUNCTION(BlueprintPure, Category = "Character Movement: Climbing")
+	int32 GetAvailableHops() const { return HopAvailability.bValid ? HopAvailability.AvailableHops : 0; }
+
+	UFUNCTION(BlueprintPure, Category = "Character Movement: Climbing")
+	bool GetAvailableHopTarget(EClimbHopDirection Direction, FVector& OutTargetPosition) const;
+
+	FORCEINLINE int32 GetNumClimbQueriesIssued() const { return NumClimbQueriesIssued; }
+
+	FORCEINLINE uint64 GetLastMovementTickCycles() const { return LastMovementTickCycles; }
+
+	FORCEINLINE int32 GetNumServerCorrections() const { return NumServerCorrections; }
+
+	FORCEINLINE int32 GetNumClimbSurfaceCorrections() const { return NumClimbSurfaceCorrections; }
+
+	//A climb action this server started is the only root motion in flight. Proxies replay it from ReplicatedClimbTransition,
+	//so the character can leave it out of RepRootMotion
+	bool IsClimbActionReplicatedAsEvent() const;
+
+	//Baked server root motion of a climb action, null if it has none on this machine
+	FORCEINLINE const FClimbRootMotionTrack* GetClimbRootMotionTrack(int32 ActionIndex) const
+	{
+		const TConstArrayView<FClimbActionDefinition> ClimbActions = GetClimbActions();
+		if (!ClimbActions.IsValidIndex(ActionIndex)) return nullptr;
+		if (ClimbActions[ActionIndex].ServerRootMotion.IsValid()) return &ClimbActions[ActionIndex].ServerRootMotion;
+
+		return RuntimeClimbRootMotionTracks.IsValidIndex(ActionIndex) && RuntimeClimbRootMotionTracks[ActionIndex].IsValid() ? &RuntimeClimbRootMotionTracks[ActionIndex] : nullptr;
+	}
+
 };
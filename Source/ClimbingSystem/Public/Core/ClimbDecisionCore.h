@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cmath>
+
+//Climb decisions on plain probe results, no engine types so it compiles and runs outside the editor.
+//Z is up and the hop input is expected in the climb frame (X forward, Y right), as UCustomMovementComponent unrotates it.
+namespace ClimbDecision
+{
+	struct FVec3
+	{
+		float X = 0.f;
+		float Y = 0.f;
+		float Z = 0.f;
+	};
+
+	inline float Dot(const FVec3& A, const FVec3& B)
+	{
+		return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+	}
+
+	inline bool IsZero(const FVec3& V)
+	{
+		return V.X == 0.f && V.Y == 0.f && V.Z == 0.f;
+	}
+
+	//Same contract as FVector::GetSafeNormal, zero for vectors too small to normalize
+	inline FVec3 SafeNormal(const FVec3& V)
+	{
+		const float SizeSquared = Dot(V, V);
+		if (SizeSquared == 1.f) return V;
+		if (SizeSquared < 1.e-8f) return FVec3();
+
+		const float InvSize = 1.f / std::sqrt(SizeSquared);
+		return FVec3{ V.X * InvSize, V.Y * InvSize, V.Z * InvSize };
+	}
+
+	struct FSettings
+	{
+		//Surfaces closer to the up axis than this are walkable, climbing stops on them
+		float MaxStopSurfaceAngle = 60.f;
+
+		//Matches THRESH_NORMALS_ARE_PARALLEL
+		float FloorParallelThreshold = 0.999845f;
+		float FloorMinDescentSpeed = 10.f;
+		float LedgeMinAscentSpeed = 10.f;
+
+		//Input mostly pushing into the wall, with less than this left in the wall plane, does not hop
+		float HopMinPlanarInput = 0.3f;
+	};
+
+	inline bool ShouldStopClimbing(bool bHasSurface, const FVec3& SurfaceNormal, const FSettings& Settings = FSettings())
+	{
+		if (!bHasSurface) return true;
+
+		//Clamped so a normal that is up to rounding error stops instead of producing NaN
+		const float DotResult = std::fmin(std::fmax(SurfaceNormal.Z, -1.f), 1.f);
+		const float DegreeDiff = std::acos(DotResult) * (180.f / 3.14159265358979323846f);
+
+		return DegreeDiff <= Settings.MaxStopSurfaceAngle;
+	}
+
+	inline bool IsFloorNormal(const FVec3& ImpactNormal, const FSettings& Settings = FSettings())
+	{
+		return std::fabs(ImpactNormal.Z) >= Settings.FloorParallelThreshold;
+	}
+
+	//UnrotatedVelocityZ is the climb velocity along the climber's up axis
+	inline bool IsDescendingToFloor(float UnrotatedVelocityZ, const FSettings& Settings = FSettings())
+	{
+		return UnrotatedVelocityZ < -Settings.FloorMinDescentSpeed;
+	}
+
+	inline bool HasReachedFloor(const FVec3* FloorNormals, int NumFloorNormals, float UnrotatedVelocityZ, const FSettings& Settings = FSettings())
+	{
+		if (!IsDescendingToFloor(UnrotatedVelocityZ, Settings)) return false;
+
+		for (int HitIndex = 0; HitIndex < NumFloorNormals; HitIndex++)
+		{
+			if (IsFloorNormal(FloorNormals[HitIndex], Settings)) return true;
+		}
+
+		return false;
+	}
+
+	inline bool HasReachedLedge(bool bEyeProbeHit, bool bHasWalkableSurface, float UnrotatedVelocityZ, const FSettings& Settings = FSettings())
+	{
+		return !bEyeProbeHit && bHasWalkableSurface && UnrotatedVelocityZ > Settings.LedgeMinAscentSpeed;
+	}
+
+	enum class EHopDirection : unsigned char
+	{
+		Up,
+		Down,
+		Right,
+		Left,
+		None
+	};
+
+	//Eight sectors of the wall plane, counter clockwise from right
+	enum class EHopOctant : unsigned char
+	{
+		Right,
+		UpRight,
+		Up,
+		UpLeft,
+		Left,
+		DownLeft,
+		Down,
+		DownRight,
+		None
+	};
+
+	inline bool HasPlanarHopInput(const FVec3& InputDirection, const FSettings& Settings)
+	{
+		return InputDirection.Y * InputDirection.Y + InputDirection.Z * InputDirection.Z >= Settings.HopMinPlanarInput * Settings.HopMinPlanarInput;
+	}
+
+	//The dominant axis of the input in the wall plane, so a diagonal hops up or down rather than always left
+	inline EHopDirection SelectHopDirection(const FVec3& UnrotatedInput, const FSettings& Settings = FSettings())
+	{
+		const FVec3 InputDirection = SafeNormal(UnrotatedInput);
+		if (!HasPlanarHopInput(InputDirection, Settings)) return EHopDirection::None;
+
+		if (std::fabs(InputDirection.Z) >= std::fabs(InputDirection.Y))
+		{
+			return InputDirection.Z >= 0.f ? EHopDirection::Up : EHopDirection::Down;
+		}
+
+		return InputDirection.Y >= 0.f ? EHopDirection::Right : EHopDirection::Left;
+	}
+
+	inline EHopOctant SelectHopOctant(const FVec3& UnrotatedInput, const FSettings& Settings = FSettings())
+	{
+		const FVec3 InputDirection = SafeNormal(UnrotatedInput);
+		if (!HasPlanarHopInput(InputDirection, Settings)) return EHopOctant::None;
+
+		const float SectorSize = 3.14159265358979323846f * 0.25f;
+		const float Angle = std::atan2(InputDirection.Z, InputDirection.Y);
+		const int Sector = (int)std::floor(Angle / SectorSize + 0.5f);
+
+		return (EHopOctant)((Sector + 8) % 8);
+	}
+
+	struct FVaultProbe
+	{
+		bool bHit = false;
+		FVec3 ImpactPoint;
+	};
+
+	//The start probe sits in front of the obstacle top, the land probe past it on the far side
+	inline bool ChooseVaultTargets(const FVaultProbe& StartProbe, const FVaultProbe& LandProbe, FVec3& OutStart, FVec3& OutLand)
+	{
+		OutStart = StartProbe.bHit ? StartProbe.ImpactPoint : FVec3();
+		OutLand = LandProbe.bHit && StartProbe.bHit ? LandProbe.ImpactPoint : FVec3();
+
+		return !IsZero(OutStart) && !IsZero(OutLand);
+	}
+}
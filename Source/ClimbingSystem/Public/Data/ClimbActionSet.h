@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Components/ClimbStateMachine.h"
+#include "Components/ClimbRootMotion.h"
+#include "ClimbActionSet.generated.h"
+
+class UAnimMontage;
+
+//What the movement component does once an action's montage has finished or blended out
+UENUM(BlueprintType)
+enum class EClimbActionFollowUp : uint8
+{
+	None,
+	StartClimbing,
+	Walk
+};
+
+USTRUCT(BlueprintType)
+struct FClimbActionDefinition
+{
+	GENERATED_BODY()
+
+	//Key the movement component plays the action by, e.g. "HopUp"
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FName ActionName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TSoftObjectPtr<UAnimMontage> Montage;
+
+	//Filled in order from the locations passed to PlayClimbAction
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TArray<FName> WarpTargetNames;
+
+	//Climb state held while the montage plays
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EClimbState State = EClimbState::None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EClimbActionFollowUp FollowUp = EClimbActionFollowUp::None;
+
+	//Root motion and warp windows baked from the montage on save, replayed by dedicated servers instead of the montage
+	UPROPERTY(VisibleAnywhere)
+	FClimbRootMotionTrack ServerRootMotion;
+};
+
+/**
+ * Montage driven climb actions. Montages are soft references the movement component streams in once a climbable surface is close,
+ * so characters that never climb never load them.
+ */
+UCLASS(BlueprintType)
+class CLIMBINGSYSTEM_API UClimbActionSet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	FORCEINLINE const TArray<FClimbActionDefinition>& GetActions() const { return Actions; }
+
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+
+private:
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing")
+	float ServerRootMotionSampleRate = 30.f;
+
+	//At most 255 actions, the index is the action id
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing")
+	TArray<FClimbActionDefinition> Actions;
+};
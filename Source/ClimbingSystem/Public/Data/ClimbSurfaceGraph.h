@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ClimbSurfaceGraph.generated.h"
+
+UENUM(BlueprintType)
+enum class EClimbGraphNodeType : uint8
+{
+	GrabPoint,
+	Ledge
+};
+
+UENUM(BlueprintType)
+enum class EClimbHopDirection : uint8
+{
+	Up,
+	Down,
+	Right,
+	Left
+};
+
+USTRUCT(BlueprintType)
+struct FClimbGraphNode
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FVector3f Normal = FVector3f::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EClimbGraphNodeType Type = EClimbGraphNodeType::GrabPoint;
+
+	//Range into UClimbSurfaceGraph::Edges
+	UPROPERTY(VisibleAnywhere)
+	int32 FirstEdge = 0;
+
+	UPROPERTY(VisibleAnywhere)
+	uint8 NumEdges = 0;
+};
+
+USTRUCT()
+struct FClimbGraphEdge
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	int32 TargetNode = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere)
+	EClimbHopDirection Direction = EClimbHopDirection::Up;
+};
+
+//Hop lengths the bake aims its edges at, measured along the wall from the grab point a hop starts from
+struct FClimbGraphHopSettings
+{
+	//Indexed by EClimbHopDirection, the distances the CheckCanHop probes and their montages were authored for
+	float Distances[4] = { 54.f, 236.f, 110.f, 110.f };
+
+	//Largest difference from the authored length, and largest sideways drift, a grab point may have and still take the hop
+	float Tolerance = 40.f;
+
+	//Up hops also need a grab point this far above the target, the wall CheckCanHopUp's safety probe looks for
+	float UpSafetyHeight = 160.f;
+
+	float UpSafetyRadius = 30.f;
+};
+
+//Range of nodes stored contiguously in one grid cell
+USTRUCT()
+struct FClimbGraphCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	int32 FirstNode = 0;
+
+	UPROPERTY(VisibleAnywhere)
+	int32 NumNodes = 0;
+};
+
+/**
+ * Ledges, grab points and hop edges baked from a level's climbable primitives by the ClimbGraphBake commandlet.
+ * Nodes are sorted by uniform grid cell so every lookup only walks the few cells around the query.
+ */
+UCLASS(BlueprintType)
+class CLIMBINGSYSTEM_API UClimbSurfaceGraph : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//Nearest node of the given type within LateralTolerance of the ray, facing back along it. Behaves like a line trace against the baked points.
+	bool FindNodeAlongRay(const FVector& Start, const FVector& Direction, float MaxDistance, float LateralTolerance, EClimbGraphNodeType Type, int32& OutNodeIndex) const;
+
+	//Nearest node of the given type within Radius
+	bool FindNearestNode(const FVector& Location, float Radius, EClimbGraphNodeType Type, int32& OutNodeIndex) const;
+
+	//Follows the baked hop edge of the grab point nearest to FromLocation
+	bool FindHopTarget(const FVector& FromLocation, float SnapRadius, EClimbHopDirection Direction, int32& OutNodeIndex) const;
+
+	//True when any baked node lies within Radius, i.e. the baked data is authoritative for this area
+	bool HasCoverage(const FVector& Location, float Radius) const;
+
+	FORCEINLINE const FClimbGraphNode& GetNode(int32 NodeIndex) const { return Nodes[NodeIndex]; }
+
+	FORCEINLINE int32 GetNumNodes() const { return Nodes.Num(); }
+
+	FORCEINLINE FIntVector GetCellCoord(const FVector& Location) const
+	{
+		return FIntVector(
+			FMath::FloorToInt(Location.X / CellSize),
+			FMath::FloorToInt(Location.Y / CellSize),
+			FMath::FloorToInt(Location.Z / CellSize)
+		);
+	}
+
+#if WITH_EDITOR
+	//Sorts the nodes into grid order and rebuilds cells and hop edges. Used by the bake commandlet.
+	void Build(TArray<FClimbGraphNode>&& InNodes, float InCellSize, const FClimbGraphHopSettings& HopSettings);
+#endif
+
+private:
+	template<typename FunctionType>
+	void ForEachNodeInRadius(const FVector& Location, float Radius, FunctionType Function) const;
+
+#if WITH_EDITOR
+	//The wall goes on above an up hop target, so the hop does not land on a strip just below a ledge
+	bool HasGrabPointAbove(const FClimbGraphNode& Node, const FVector& WallUp, const FClimbGraphHopSettings& HopSettings) const;
+#endif
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Graph")
+	float CellSize = 200.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Graph")
+	TArray<FClimbGraphNode> Nodes;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Graph")
+	TArray<FClimbGraphEdge> Edges;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Graph")
+	TMap<FIntVector, FClimbGraphCell> Cells;
+};
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "ClimbReplicationGraph.generated.h"
+
+/**
+ * Grid spatialized replication graph. Climbers are grouped into grid cells for relevancy and replicate at the
+ * per-actor frequency UCustomMovementComponent sets from their climb state.
+ */
+UCLASS(Transient, Config = Engine)
+class CLIMBINGSYSTEM_API UClimbReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalGraphNodes() override;
+
+	//The graph caches each actor's replication period, refresh it after NetUpdateFrequency changed at runtime
+	void OnNetUpdateFrequencyChanged(AActor* Actor);
+
+	static UClimbReplicationGraph* Get(const UWorld* World);
+
+private:
+	UPROPERTY(Config)
+	float GridCellSize = 10000.f;
+};
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbBatchSubsystem.generated.h"
+
+class UCustomMovementComponent;
+
+/**
+ * Integrates every registered AI climber in one pass per frame.
+ * Climb state lives in contiguous arrays, one element per climber, so velocity, rotation and snap math run over packed data
+ * instead of hopping between movement components.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	int32 RegisterClimber(UCustomMovementComponent* Climber);
+
+	void UnregisterClimber(UCustomMovementComponent* Climber);
+
+	FORCEINLINE int32 GetNumClimbers() const { return Climbers.Num(); }
+
+	//Cost of the last batched step, the climbers' own TickComponent cycles do not include it
+	FORCEINLINE uint64 GetLastTickCycles() const { return LastTickCycles; }
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void RemoveClimberAt(int32 BatchIndex);
+
+	void GatherClimbers(float DeltaTime);
+
+	void IntegrateClimbers(float DeltaTime);
+
+	void ApplyClimbers(float DeltaTime);
+
+	UPROPERTY()
+	TArray<UCustomMovementComponent*> Climbers;
+
+	TArray<FVector> Locations;
+
+	TArray<FQuat> Rotations;
+
+	TArray<FVector> Velocities;
+
+	TArray<FVector> Accelerations;
+
+	TArray<FVector> SurfaceLocations;
+
+	TArray<FVector> SurfaceNormals;
+
+	TArray<float> MaxSpeeds;
+
+	TArray<float> CapsuleRadii;
+
+	TArray<float> BrakingDecelerations;
+
+	TArray<FVector> MoveDeltas;
+
+	//Non-zero while the climber is integrated by the batch this frame; root motion and stopped climbers are skipped
+	TArray<uint8> ActiveFlags;
+
+	uint64 LastTickCycles = 0;
+};
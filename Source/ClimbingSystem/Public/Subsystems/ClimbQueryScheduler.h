@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbQueryScheduler.generated.h"
+
+class UCustomMovementComponent;
+
+//Ordered from least to most urgent
+enum class EClimbQueryPriority : uint8
+{
+	AIMaintenance,
+	AITransition,
+	PlayerMaintenance,
+	PlayerInput
+};
+
+enum class EClimbQueryKind : uint8
+{
+	StartClimbing,
+	Hop
+};
+
+/**
+ * Keeps climb scene queries inside a per-frame time budget ("Climb.Scheduler.BudgetUs").
+ * Player probes always run and are only charged against the budget. AI maintenance probes are skipped for the frame once it is spent,
+ * and AI transition probes are queued and run in priority order from whatever budget is left at the end of the frame.
+ * Anything that has waited "Climb.Scheduler.MaxWaitFrames" frames runs regardless, so nothing starves.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbQueryScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//Returns false when the caller should skip its probes this frame and keep its last result, InOutDeferredFrame tracks how long it has been skipping
+	bool TryAcquireBudget(EClimbQueryPriority Priority, uint64& InOutDeferredFrame);
+
+	void EnqueueQuery(UCustomMovementComponent* Requester, EClimbQueryKind Kind, EClimbQueryPriority Priority);
+
+	void ChargeQueryCycles(uint64 Cycles);
+
+	FORCEINLINE int32 GetNumPendingQueries() const { return PendingQueries.Num(); }
+
+	FORCEINLINE int32 GetNumDeferredThisFrame() const { return NumDeferredThisFrame; }
+
+	FORCEINLINE int64 GetNumDeferredTotal() const { return NumDeferredTotal; }
+
+	FORCEINLINE double GetUsedMicrosecondsThisFrame() const { return UsedMicroseconds; }
+
+	FORCEINLINE double GetAverageWaitFrames() const { return NumWaitSamples > 0 ? TotalWaitFrames / NumWaitSamples : 0.0; }
+
+	FORCEINLINE uint64 GetMaxWaitFrames() const { return MaxWaitFrames; }
+
+	//Cost of running the queued queries last frame, the requesting climbers' TickComponent cycles do not include it
+	FORCEINLINE uint64 GetLastTickCycles() const { return LastTickCycles; }
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPendingClimbQuery
+	{
+		TWeakObjectPtr<UCustomMovementComponent> Requester;
+
+		EClimbQueryKind Kind;
+
+		EClimbQueryPriority Priority;
+
+		uint64 RequestFrame;
+	};
+
+	void BeginFrameIfNeeded();
+
+	void RunPendingQueries();
+
+	bool HasBudgetLeft() const;
+
+	void RecordWait(uint64 RequestFrame);
+
+	TArray<FPendingClimbQuery> PendingQueries;
+
+	uint64 BudgetFrame = 0;
+
+	double UsedMicroseconds = 0.0;
+
+	int32 NumDeferredThisFrame = 0;
+
+	int64 NumDeferredTotal = 0;
+
+	double TotalWaitFrames = 0.0;
+
+	int64 NumWaitSamples = 0;
+
+	uint64 MaxWaitFrames = 0;
+
+	uint64 LastTickCycles = 0;
+};
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbSurfaceGraphSubsystem.generated.h"
+
+class UClimbSurfaceGraph;
+
+/**
+ * Loads the climb graph baked for the current level, if there is one.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbSurfaceGraphSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//Package baked graphs are saved to and loaded from: /Game/ClimbGraphs/<MapName>_ClimbGraph
+	static FString GetGraphPackageName(const FString& MapPackageName);
+
+	FORCEINLINE const UClimbSurfaceGraph* GetGraph() const { return Graph; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+private:
+	UPROPERTY()
+	UClimbSurfaceGraph* Graph;
+};
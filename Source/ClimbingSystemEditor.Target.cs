@@ -11,5 +11,6 @@ public class ClimbingSystemEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("ClimbingSystem");
+		ExtraModuleNames.Add("ClimbingSystemEditor");
 	}
 }
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+
+public class ClimbingSystemEditor : ModuleRules
+{
+	public ClimbingSystemEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"ClimbingSystem"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"UnrealEd",
+			"AssetRegistry"
+		});
+	}
+}
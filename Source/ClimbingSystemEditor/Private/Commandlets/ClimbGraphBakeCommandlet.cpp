@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/ClimbGraphBakeCommandlet.h"
+#include "Components/CustomMovementComponent.h"
+#include "Data/ClimbSurfaceGraph.h"
+#include "Subsystems/ClimbSurfaceGraphSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/PrimitiveComponent.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbGraphBake, Log, All);
+
+UClimbGraphBakeCommandlet::UClimbGraphBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UClimbGraphBakeCommandlet::Main(const FString& Params)
+{
+	FString MapPackageName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapPackageName))
+	{
+		UE_LOG(LogClimbGraphBake, Error, TEXT("Usage: -run=ClimbGraphBake -Map=/Game/Path/To/Map [-Spacing=25] [-CellSize=200] [-HopTolerance=40] [-Character=ClassPath]"));
+		return 1;
+	}
+
+	float CellSize = 200.f;
+	FClimbGraphHopSettings HopSettings;
+	FString CharacterClassPath = TEXT("/Game/ClimbSystem/BP_ClimbingSystemCharacter.BP_ClimbingSystemCharacter_C");
+
+	FParse::Value(*Params, TEXT("Spacing="), GrabSpacing);
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("HopTolerance="), HopSettings.Tolerance);
+	FParse::Value(*Params, TEXT("Character="), CharacterClassPath);
+
+	//Edges aim at the hop lengths the character's montages were authored for
+	if (const UClass* CharacterClass = LoadClass<ACharacter>(nullptr, *CharacterClassPath))
+	{
+		const float EyeHeight = CharacterClass->GetDefaultObject<ACharacter>()->BaseEyeHeight;
+
+		for (int32 DirectionIndex = 0; DirectionIndex < UE_ARRAY_COUNT(HopSettings.Distances); DirectionIndex++)
+		{
+			HopSettings.Distances[DirectionIndex] = UCustomMovementComponent::GetCardinalHopDistance((EClimbHopDirection)DirectionIndex, EyeHeight);
+		}
+	}
+
+	GrabSpacing = FMath::Max(GrabSpacing, 5.f);
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogClimbGraphBake, Error, TEXT("Could not load map %s"), *MapPackageName);
+		return 1;
+	}
+
+	if (World->IsPartitionedWorld())
+	{
+		UE_LOG(LogClimbGraphBake, Warning, TEXT("%s uses World Partition, only actors loaded with the persistent level are baked"), *MapPackageName);
+	}
+
+	//Scene queries need a physics scene with the level's collision registered
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitWorld(UWorld::InitializationValues()
+		.AllowAudioPlayback(false)
+		.RequiresHitProxies(false)
+		.CreatePhysicsScene(true)
+		.CreateNavigation(false)
+		.CreateAISystem(false)
+		.ShouldSimulatePhysics(false)
+		.SetTransactional(false));
+	World->UpdateWorldComponents(true, false);
+
+	ObjectQueryParams = FCollisionObjectQueryParams(LoadClimbableObjectTypes(CharacterClassPath));
+	QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ClimbGraphBake), false);
+
+	TArray<FClimbGraphNode> Nodes;
+	int32 NumPrimitives = 0;
+
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		ActorIt->ForEachComponent<UPrimitiveComponent>(false, [&](UPrimitiveComponent* Primitive)
+		{
+			if (!Primitive->IsCollisionEnabled()) return;
+			if (!ObjectQueryParams.IsValid() || !(ObjectQueryParams.GetQueryBitfield() & ECC_TO_BITFIELD(Primitive->GetCollisionObjectType()))) return;
+
+			BakePrimitive(World, Primitive, Nodes);
+			NumPrimitives++;
+		});
+	}
+
+	const FString GraphPackageName = UClimbSurfaceGraphSubsystem::GetGraphPackageName(MapPackageName);
+	const FString GraphAssetName = FPackageName::GetShortName(GraphPackageName);
+
+	UPackage* GraphPackage = CreatePackage(*GraphPackageName);
+	UClimbSurfaceGraph* Graph = NewObject<UClimbSurfaceGraph>(GraphPackage, *GraphAssetName, RF_Public | RF_Standalone);
+
+	const int32 NumNodes = Nodes.Num();
+	Graph->Build(MoveTemp(Nodes), CellSize, HopSettings);
+
+	FAssetRegistryModule::AssetCreated(Graph);
+	GraphPackage->MarkPackageDirty();
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError;
+
+	const FString GraphFileName = FPackageName::LongPackageNameToFilename(GraphPackageName, FPackageName::GetAssetPackageExtension());
+	const bool bSaved = UPackage::SavePackage(GraphPackage, Graph, *GraphFileName, SaveArgs);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	if (!bSaved)
+	{
+		UE_LOG(LogClimbGraphBake, Error, TEXT("Failed to save %s"), *GraphFileName);
+		return 1;
+	}
+
+	UE_LOG(LogClimbGraphBake, Display, TEXT("Baked %d nodes from %d climbable primitives into %s"), NumNodes, NumPrimitives, *GraphPackageName);
+	return 0;
+}
+
+TArray<TEnumAsByte<EObjectTypeQuery> > UClimbGraphBakeCommandlet::LoadClimbableObjectTypes(const FString& CharacterClassPath) const
+{
+	if (const UClass* CharacterClass = LoadClass<ACharacter>(nullptr, *CharacterClassPath))
+	{
+		const ACharacter* CharacterCDO = CharacterClass->GetDefaultObject<ACharacter>();
+
+		if (const UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(CharacterCDO->GetCharacterMovement()))
+		{
+			return MovementComponent->GetClimbableSurfaceTraceTypes();
+		}
+	}
+
+	UE_LOG(LogClimbGraphBake, Warning, TEXT("Could not read ClimbableSurfaceTraceTypes from %s, baking WorldStatic"), *CharacterClassPath);
+
+	TArray<TEnumAsByte<EObjectTypeQuery> > DefaultObjectTypes;
+	DefaultObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
+	return DefaultObjectTypes;
+}
+
+void UClimbGraphBakeCommandlet::BakePrimitive(UWorld* World, UPrimitiveComponent* Primitive, TArray<FClimbGraphNode>& OutNodes) const
+{
+	const FBox Bounds = Primitive->Bounds.GetBox();
+	const FVector Center = Bounds.GetCenter();
+	const FVector Extent = Bounds.GetExtent();
+
+	const FVector FaceNormals[] = { FVector::ForwardVector, -FVector::ForwardVector, FVector::RightVector, -FVector::RightVector };
+
+	for (const FVector& FaceNormal : FaceNormals)
+	{
+		const FVector FaceTangent = FVector::CrossProduct(FVector::UpVector, FaceNormal);
+		const float HalfWidth = FMath::Abs(FVector::DotProduct(Extent, FaceTangent));
+		const float HalfDepth = FMath::Abs(FVector::DotProduct(Extent, FaceNormal));
+
+		const int32 NumColumns = FMath::FloorToInt(2.f * HalfWidth / GrabSpacing) + 1;
+		const int32 NumRows = FMath::FloorToInt(2.f * Extent.Z / GrabSpacing) + 1;
+
+		for (int32 Column = 0; Column < NumColumns; Column++)
+		{
+			FHitResult TopmostWallHit;
+
+			for (int32 Row = 0; Row < NumRows; Row++)
+			{
+				const FVector SamplePoint = Center
+					+ FaceTangent * (-HalfWidth + Column * GrabSpacing)
+					+ FVector::UpVector * (-Extent.Z + Row * GrabSpacing);
+
+				const FVector Start = SamplePoint + FaceNormal * (HalfDepth + 50.f);
+				const FVector End = SamplePoint - FaceNormal * HalfDepth;
+
+				FHitResult WallHit;
+				World->LineTraceSingleByObjectType(WallHit, Start, End, ObjectQueryParams, QueryParams);
+
+				//Occluded by something else, or too flat to climb (same 60 degree rule as CheckShouldStopClimbing)
+				if (!WallHit.bBlockingHit || WallHit.GetComponent() != Primitive) continue;
+				if (FMath::Abs(WallHit.ImpactNormal.Z) >= 0.5f) continue;
+
+				FClimbGraphNode& GrabNode = OutNodes.AddDefaulted_GetRef();
+				GrabNode.Location = WallHit.ImpactPoint;
+				GrabNode.Normal = FVector3f(WallHit.ImpactNormal);
+				GrabNode.Type = EClimbGraphNodeType::GrabPoint;
+
+				TopmostWallHit = WallHit;
+			}
+
+			if (!TopmostWallHit.bBlockingHit) continue;
+
+			//A walkable top just above the highest grab point, with headroom, makes this column a ledge
+			const FVector LedgeProbeStart = TopmostWallHit.ImpactPoint - TopmostWallHit.ImpactNormal * 20.f + FVector::UpVector * (GrabSpacing + 100.f);
+			const FVector LedgeProbeEnd = LedgeProbeStart - FVector::UpVector * (2.f * GrabSpacing + 100.f);
+
+			FHitResult TopHit;
+			World->LineTraceSingleByObjectType(TopHit, LedgeProbeStart, LedgeProbeEnd, ObjectQueryParams, QueryParams);
+
+			if (!TopHit.bBlockingHit || TopHit.bStartPenetrating || TopHit.ImpactNormal.Z < 0.7f) continue;
+			if (TopHit.ImpactPoint.Z < TopmostWallHit.ImpactPoint.Z) continue;
+
+			FClimbGraphNode& LedgeNode = OutNodes.AddDefaulted_GetRef();
+			LedgeNode.Location = FVector(TopmostWallHit.ImpactPoint.X, TopmostWallHit.ImpactPoint.Y, TopHit.ImpactPoint.Z);
+			LedgeNode.Normal = FVector3f(TopmostWallHit.ImpactNormal);
+			LedgeNode.Type = EClimbGraphNodeType::Ledge;
+		}
+	}
+}
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbGraphBakeCommandlet.generated.h"
+
+class UWorld;
+class UPrimitiveComponent;
+struct FClimbGraphNode;
+
+/**
+ * Bakes the climbable surfaces of a level into a UClimbSurfaceGraph asset.
+ *
+ * UnrealEditor-Cmd ClimbingSystem.uproject -run=ClimbGraphBake -Map=/Game/ClimbSystem/Maps/MyMap
+ *	[-Spacing=25] [-CellSize=200] [-HopTolerance=40] [-Character=/Game/ClimbSystem/BP_ClimbingSystemCharacter.BP_ClimbingSystemCharacter_C]
+ */
+UCLASS()
+class CLIMBINGSYSTEMEDITOR_API UClimbGraphBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbGraphBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	TArray<TEnumAsByte<EObjectTypeQuery> > LoadClimbableObjectTypes(const FString& CharacterClassPath) const;
+
+	void BakePrimitive(UWorld* World, UPrimitiveComponent* Primitive, TArray<FClimbGraphNode>& OutNodes) const;
+
+	FCollisionObjectQueryParams ObjectQueryParams;
+
+	FCollisionQueryParams QueryParams;
+
+	float GrabSpacing = 25.f;
+};
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/ClimbDecisionCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace ClimbDecision;
+
+namespace
+{
+	constexpr int NumInputs = 1024;
+
+	//A fixed table of inputs, indexed per call so branches see a realistic mix
+	struct FDecisionInputs
+	{
+		FDecisionInputs()
+			: Normals(NumInputs)
+			, Inputs(NumInputs)
+			, Speeds(NumInputs)
+		{
+			for (int Index = 0; Index < NumInputs; Index++)
+			{
+				const float Angle = Index * 0.0061359f;
+				Normals[Index] = SafeNormal(FVec3{ std::cos(Angle), 0.f, std::sin(Angle) });
+				Inputs[Index] = FVec3{ 0.1f, std::cos(Angle * 8.f), std::sin(Angle * 8.f) };
+				Speeds[Index] = (float)(Index % 200) - 100.f;
+			}
+		}
+
+		std::vector<FVec3> Normals;
+
+		std::vector<FVec3> Inputs;
+
+		std::vector<float> Speeds;
+	};
+
+	const FDecisionInputs& GetInputs()
+	{
+		static const FDecisionInputs DecisionInputs;
+		return DecisionInputs;
+	}
+
+	template<typename FunctionType>
+	void RunDecision(benchmark::State& State, FunctionType Function)
+	{
+		int Index = 0;
+		for (auto _ : State)
+		{
+			benchmark::DoNotOptimize(Function(Index));
+			Index = (Index + 1) & (NumInputs - 1);
+		}
+	}
+}
+
+static void BM_ShouldStopClimbing(benchmark::State& State)
+{
+	const FDecisionInputs& Inputs = GetInputs();
+	RunDecision(State, [&](int Index) { return ShouldStopClimbing(true, Inputs.Normals[Index]); });
+}
+BENCHMARK(BM_ShouldStopClimbing);
+
+static void BM_HasReachedFloor(benchmark::State& State)
+{
+	const FDecisionInputs& Inputs = GetInputs();
+	RunDecision(State, [&](int Index) { return HasReachedFloor(&Inputs.Normals[Index], 1, Inputs.Speeds[Index]); });
+}
+BENCHMARK(BM_HasReachedFloor);
+
+static void BM_HasReachedLedge(benchmark::State& State)
+{
+	const FDecisionInputs& Inputs = GetInputs();
+	RunDecision(State, [&](int Index) { return HasReachedLedge((Index & 1) != 0, (Index & 2) != 0, Inputs.Speeds[Index]); });
+}
+BENCHMARK(BM_HasReachedLedge);
+
+static void BM_SelectHopDirection(benchmark::State& State)
+{
+	const FDecisionInputs& Inputs = GetInputs();
+	RunDecision(State, [&](int Index) { return SelectHopDirection(Inputs.Inputs[Index]); });
+}
+BENCHMARK(BM_SelectHopDirection);
+
+static void BM_SelectHopOctant(benchmark::State& State)
+{
+	const FDecisionInputs& Inputs = GetInputs();
+	RunDecision(State, [&](int Index) { return SelectHopOctant(Inputs.Inputs[Index]); });
+}
+BENCHMARK(BM_SelectHopOctant);
+
+static void BM_ChooseVaultTargets(benchmark::State& State)
+{
+	const FVaultProbe StartProbe{ true, FVec3{ 100.f, 0.f, 50.f } };
+	const FVaultProbe LandProbe{ true, FVec3{ 300.f, 0.f, 0.f } };
+
+	RunDecision(State, [&](int Index)
+	{
+		FVec3 Start;
+		FVec3 Land;
+		return ChooseVaultTargets(StartProbe, (Index & 1) ? LandProbe : FVaultProbe(), Start, Land);
+	});
+}
+BENCHMARK(BM_ChooseVaultTargets);
+
+BENCHMARK_MAIN();
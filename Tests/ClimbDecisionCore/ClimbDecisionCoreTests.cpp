@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/ClimbDecisionCore.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace ClimbDecision;
+
+static int NumFailures = 0;
+
+#define CLIMB_EXPECT(Condition) \
+	do \
+	{ \
+		if (!(Condition)) \
+		{ \
+			std::printf("%s:%d: expected %s\n", __FILE__, __LINE__, #Condition); \
+			NumFailures++; \
+		} \
+	} while (0)
+
+static FVec3 FromDegrees(float Degrees)
+{
+	//Unit vector in the wall plane, 0 is right and 90 is up
+	const float Radians = Degrees * (3.14159265358979323846f / 180.f);
+	return FVec3{ 0.f, std::cos(Radians), std::sin(Radians) };
+}
+
+static void TestShouldStopClimbing()
+{
+	CLIMB_EXPECT(ShouldStopClimbing(false, FVec3{ 1.f, 0.f, 0.f }));
+
+	//A vertical wall keeps climbing, a floor and a gentle slope stop it
+	CLIMB_EXPECT(!ShouldStopClimbing(true, FVec3{ 1.f, 0.f, 0.f }));
+	CLIMB_EXPECT(ShouldStopClimbing(true, FVec3{ 0.f, 0.f, 1.f }));
+	CLIMB_EXPECT(ShouldStopClimbing(true, SafeNormal(FVec3{ 1.f, 0.f, 1.f })));
+
+	//Overhangs point down and never stop
+	CLIMB_EXPECT(!ShouldStopClimbing(true, SafeNormal(FVec3{ 1.f, 0.f, -1.f })));
+
+	//Slightly over one from rounding must not produce NaN and must stop
+	CLIMB_EXPECT(ShouldStopClimbing(true, FVec3{ 0.f, 0.f, 1.0000001f }));
+}
+
+static void TestHasReachedFloor()
+{
+	const FVec3 Floor{ 0.f, 0.f, 1.f };
+	const FVec3 Wall{ 1.f, 0.f, 0.f };
+
+	CLIMB_EXPECT(HasReachedFloor(&Floor, 1, -50.f));
+	CLIMB_EXPECT(!HasReachedFloor(&Floor, 1, 0.f));
+	CLIMB_EXPECT(!HasReachedFloor(&Floor, 1, -5.f));
+	CLIMB_EXPECT(!HasReachedFloor(&Wall, 1, -50.f));
+	CLIMB_EXPECT(!HasReachedFloor(nullptr, 0, -50.f));
+
+	const FVec3 Mixed[] = { Wall, Floor };
+	CLIMB_EXPECT(HasReachedFloor(Mixed, 2, -50.f));
+
+	CLIMB_EXPECT(IsDescendingToFloor(-50.f));
+	CLIMB_EXPECT(!IsDescendingToFloor(-10.f));
+}
+
+static void TestSelectHopDirection()
+{
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(0.f)) == EHopDirection::Right);
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(90.f)) == EHopDirection::Up);
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(180.f)) == EHopDirection::Left);
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(270.f)) == EHopDirection::Down);
+
+	//Diagonals follow the dominant axis instead of falling through to left
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(30.f)) == EHopDirection::Right);
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(60.f)) == EHopDirection::Up);
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(-60.f)) == EHopDirection::Down);
+	CLIMB_EXPECT(SelectHopDirection(FromDegrees(150.f)) == EHopDirection::Left);
+
+	//Input into the wall or no input at all does not hop
+	CLIMB_EXPECT(SelectHopDirection(FVec3{ 1.f, 0.f, 0.f }) == EHopDirection::None);
+	CLIMB_EXPECT(SelectHopDirection(FVec3{}) == EHopDirection::None);
+}
+
+static void TestSelectHopOctant()
+{
+	const EHopOctant Expected[] =
+	{
+		EHopOctant::Right, EHopOctant::UpRight, EHopOctant::Up, EHopOctant::UpLeft,
+		EHopOctant::Left, EHopOctant::DownLeft, EHopOctant::Down, EHopOctant::DownRight
+	};
+
+	for (int Sector = 0; Sector < 8; Sector++)
+	{
+		//Centre of each sector and just inside both of its borders
+		CLIMB_EXPECT(SelectHopOctant(FromDegrees(Sector * 45.f)) == Expected[Sector]);
+		CLIMB_EXPECT(SelectHopOctant(FromDegrees(Sector * 45.f - 22.f)) == Expected[Sector]);
+		CLIMB_EXPECT(SelectHopOctant(FromDegrees(Sector * 45.f + 22.f)) == Expected[Sector]);
+	}
+
+	CLIMB_EXPECT(SelectHopOctant(FVec3{ 1.f, 0.05f, 0.05f }) == EHopOctant::None);
+	CLIMB_EXPECT(SelectHopOctant(FVec3{}) == EHopOctant::None);
+}
+
+static void TestChooseVaultTargets()
+{
+	const FVaultProbe StartHit{ true, FVec3{ 100.f, 0.f, 50.f } };
+	const FVaultProbe LandHit{ true, FVec3{ 300.f, 0.f, 0.f } };
+	const FVaultProbe Miss;
+
+	FVec3 Start;
+	FVec3 Land;
+
+	CLIMB_EXPECT(ChooseVaultTargets(StartHit, LandHit, Start, Land));
+	CLIMB_EXPECT(Start.X == 100.f && Start.Z == 50.f);
+	CLIMB_EXPECT(Land.X == 300.f);
+
+	//No land without a start, and no vault with either missing
+	CLIMB_EXPECT(!ChooseVaultTargets(Miss, LandHit, Start, Land));
+	CLIMB_EXPECT(IsZero(Land));
+	CLIMB_EXPECT(!ChooseVaultTargets(StartHit, Miss, Start, Land));
+}
+
+int main()
+{
+	TestShouldStopClimbing();
+	TestHasReachedFloor();
+	TestSelectHopDirection();
+	TestSelectHopOctant();
+	TestChooseVaultTargets();
+
+	if (NumFailures > 0)
+	{
+		std::printf("%d climb decision checks failed\n", NumFailures);
+		return 1;
+	}
+
+	std::printf("All climb decision checks passed\n");
+	return 0;
+}